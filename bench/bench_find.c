@@ -0,0 +1,133 @@
+/**
+ * \file            bench_find.c
+ * \brief           Single-thread \ref lwrb_find benchmark
+ *
+ * Compares library implementation against the previous byte-by-byte search,
+ * for different needle lengths. Needle is placed at the very end of the data,
+ * across the end of the buffer, so that whole buffer content is scanned.
+ *
+ * Usage: lwrb_bench_find [buffer_size] [iterations]
+ */
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include "lwrb/lwrb.h"
+
+/**
+ * \brief           Reference byte-by-byte search, as implemented before
+ */
+static uint8_t
+find_reference(const lwrb_t* buff, const void* bts, lwrb_sz_t len, lwrb_sz_t start_offset, lwrb_sz_t* found_idx) {
+    lwrb_sz_t full, r_ptr, max_x;
+    const uint8_t* needle = bts;
+
+    *found_idx = 0;
+    full = lwrb_get_full(buff);
+    if (full < (len + start_offset)) {
+        return 0;
+    }
+    r_ptr = buff->r_ptr;
+    max_x = full - len;
+    for (lwrb_sz_t skip_x = start_offset; skip_x <= max_x; ++skip_x) {
+        lwrb_sz_t idx = (r_ptr + skip_x) % buff->size;
+        uint8_t found = 1;
+
+        for (lwrb_sz_t i = 0; i < len; ++i) {
+            if (buff->buff[idx] != needle[i]) {
+                found = 0;
+                break;
+            }
+            if (++idx >= buff->size) {
+                idx = 0;
+            }
+        }
+        if (found) {
+            *found_idx = skip_x;
+            return 1;
+        }
+    }
+    return 0;
+}
+
+static double
+now_sec(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (double)ts.tv_sec + (double)ts.tv_nsec / 1e9;
+}
+
+int
+main(int argc, char** argv) {
+    static const lwrb_sz_t needle_lens[] = {1, 4, 16, 64};
+    size_t buffer_size = 4UL * 1024UL * 1024UL + 1;
+    size_t iterations = 20;
+    uint8_t *data, *fill, needle[64];
+    lwrb_sz_t data_len, idx_ref, idx_lib;
+    lwrb_t rb;
+    int retval = 0;
+
+    if (argc > 1) {
+        buffer_size = strtoul(argv[1], NULL, 0);
+    }
+    if (argc > 2) {
+        iterations = strtoul(argv[2], NULL, 0);
+    }
+    if (buffer_size < 2 * sizeof(needle) || iterations == 0) {
+        printf("Invalid arguments\r\n");
+        return -1;
+    }
+
+    /* Fill buffer with pseudo-random letters, starting in the middle of the memory */
+    data = malloc(buffer_size);
+    fill = malloc(buffer_size);
+    data_len = buffer_size - 1;
+    srand(1);
+    for (size_t i = 0; i < data_len; ++i) {
+        fill[i] = (uint8_t)('a' + rand() % 26);
+    }
+    for (size_t i = 0; i < sizeof(needle); ++i) {
+        needle[i] = (uint8_t)('0' + i % 10);
+    }
+    lwrb_init(&rb, data, buffer_size);
+    lwrb_advance(&rb, buffer_size / 2 + sizeof(needle) / 2);
+    lwrb_skip(&rb, buffer_size / 2 + sizeof(needle) / 2);
+
+    for (size_t n = 0; n < sizeof(needle_lens) / sizeof(needle_lens[0]); ++n) {
+        lwrb_sz_t nlen = needle_lens[n];
+        double t_ref, t_lib;
+        uint8_t f_ref, f_lib;
+
+        /* Needle is the last data in the buffer, crossing the end of the memory */
+        memcpy(&fill[data_len - nlen], needle, nlen);
+        lwrb_reset(&rb);
+        lwrb_advance(&rb, buffer_size - nlen / 2 - 1);
+        lwrb_skip(&rb, buffer_size - nlen / 2 - 1);
+        lwrb_write(&rb, fill, data_len);
+
+        t_ref = now_sec();
+        for (size_t i = 0; i < iterations; ++i) {
+            f_ref = find_reference(&rb, needle, nlen, 0, &idx_ref);
+        }
+        t_ref = now_sec() - t_ref;
+
+        t_lib = now_sec();
+        for (size_t i = 0; i < iterations; ++i) {
+            f_lib = lwrb_find(&rb, needle, nlen, 0, &idx_lib);
+        }
+        t_lib = now_sec() - t_lib;
+
+        printf("needle: %3u, reference: %8.1f MB/s, lwrb_find: %8.1f MB/s, speedup: %5.1fx\r\n", (unsigned)nlen,
+               (double)data_len * (double)iterations / t_ref / 1e6, (double)data_len * (double)iterations / t_lib / 1e6,
+               t_ref / t_lib);
+        if (f_ref != f_lib || idx_ref != idx_lib) {
+            printf("Result mismatch: reference %u@%u, lwrb_find %u@%u\r\n", (unsigned)f_ref, (unsigned)idx_ref,
+                   (unsigned)f_lib, (unsigned)idx_lib);
+            retval = -1;
+        }
+        memset(&fill[data_len - nlen], 'a', nlen);
+    }
+    free(fill);
+    free(data);
+    return retval;
+}
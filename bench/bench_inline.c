@@ -0,0 +1,76 @@
+/**
+ * \file            bench_inline.c
+ * \brief           Small-chunk single-thread benchmark, library and header-only build
+ *
+ * Same source is built twice, once linked with library source file
+ * and once with `LWRB_HEADER_ONLY` defined, to compare function call overhead
+ * of hot paths with tiny transfers.
+ *
+ * Usage: lwrb_bench_inline [total_bytes] [chunk_size]
+ */
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+#include "lwrb/lwrb.h"
+
+#if defined(LWRB_HEADER_ONLY)
+#define BENCH_MODE "header-only"
+#else
+#define BENCH_MODE "library"
+#endif
+
+static lwrb_t rb;
+static uint8_t rb_data[256 + 1];
+
+static double
+now_sec(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (double)ts.tv_sec + (double)ts.tv_nsec / 1e9;
+}
+
+int
+main(int argc, char** argv) {
+    size_t total_bytes = 256UL * 1024UL * 1024UL, chunk_size = 4, done;
+    uint8_t chunk[64] = {0}, sum = 0;
+    double t_rw, t_lin;
+
+    if (argc > 1) {
+        total_bytes = strtoul(argv[1], NULL, 0);
+    }
+    if (argc > 2) {
+        chunk_size = strtoul(argv[2], NULL, 0);
+    }
+    if (total_bytes == 0 || chunk_size == 0 || chunk_size > sizeof(chunk)) {
+        printf("Invalid arguments\r\n");
+        return -1;
+    }
+    lwrb_init(&rb, rb_data, sizeof(rb_data));
+
+    /* Write and read of small chunks */
+    t_rw = now_sec();
+    for (done = 0; done < total_bytes;) {
+        lwrb_write(&rb, chunk, chunk_size);
+        done += lwrb_read(&rb, chunk, chunk_size);
+    }
+    t_rw = now_sec() - t_rw;
+
+    /* Parse-in-place consumer loop, with fill level and linear block queries */
+    t_lin = now_sec();
+    for (done = 0; done < total_bytes;) {
+        lwrb_advance(&rb, chunk_size);
+        while (lwrb_get_full(&rb) > 0) {
+            lwrb_sz_t len = lwrb_get_linear_block_read_length(&rb);
+            const uint8_t* d = lwrb_get_linear_block_read_address(&rb);
+            sum += d[0];
+            len = len < chunk_size ? len : chunk_size;
+            done += lwrb_skip(&rb, len);
+        }
+    }
+    t_lin = now_sec() - t_lin;
+
+    printf("mode: %s, chunk: %lu, write/read: %.1f MB/s, linear/skip: %.1f MB/s, check: %u\r\n", BENCH_MODE,
+           (unsigned long)chunk_size, (double)total_bytes / t_rw / 1e6, (double)total_bytes / t_lin / 1e6,
+           (unsigned)sum);
+    return 0;
+}
@@ -0,0 +1,138 @@
+/**
+ * \file            bench_mpmc.c
+ * \brief           Multi-producer, multi-consumer scaling benchmark
+ *
+ * Runs every combination of `1 .. max_threads` producers and `1 .. max_threads` consumers,
+ * and prints throughput matrix. Producers and consumers write and read fixed size records,
+ * so that every record is moved as one unit.
+ *
+ * Usage: lwrb_bench_mpmc [max_threads] [total_bytes] [record_size] [buffer_size]
+ */
+#include <pthread.h>
+#include <sched.h>
+#include <stdatomic.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include "lwrb/lwrb.h"
+
+static lwrb_t rb;
+static size_t max_threads = 4;
+static size_t total_bytes = 64UL * 1024UL * 1024UL;
+static size_t record_size = 64;
+static size_t buffer_size = 64UL * 1024UL; /* Power of 2, required by multi-producer and multi-consumer */
+static size_t records_per_producer;
+static atomic_size_t records_received;
+static size_t records_total;
+
+static void*
+producer_thread(void* arg) {
+    uint8_t* rec = malloc(record_size);
+
+    (void)arg;
+    memset(rec, 0xA5, record_size);
+    for (size_t i = 0; i < records_per_producer;) {
+        if (lwrb_write_mp_ex(&rb, rec, record_size, NULL, LWRB_FLAG_WRITE_ALL)) {
+            ++i;
+        } else {
+            sched_yield();
+        }
+    }
+    free(rec);
+    return NULL;
+}
+
+static void*
+consumer_thread(void* arg) {
+    uint8_t* rec = malloc(record_size);
+
+    (void)arg;
+    while (atomic_load_explicit(&records_received, memory_order_relaxed) < records_total) {
+        if (lwrb_read_mc_ex(&rb, rec, record_size, NULL, LWRB_FLAG_READ_ALL)) {
+            atomic_fetch_add_explicit(&records_received, 1, memory_order_relaxed);
+        } else {
+            sched_yield();
+        }
+    }
+    free(rec);
+    return NULL;
+}
+
+/**
+ * \brief           Run single producer/consumer count combination
+ * \return          Throughput in units of MB/s
+ */
+static double
+run_one(size_t producers, size_t consumers) {
+    pthread_t prod[producers], cons[consumers];
+    struct timespec t_start, t_end;
+    double sec;
+
+    lwrb_reset(&rb);
+    records_per_producer = total_bytes / record_size / producers;
+    records_total = records_per_producer * producers;
+    atomic_store(&records_received, 0);
+
+    clock_gettime(CLOCK_MONOTONIC, &t_start);
+    for (size_t i = 0; i < consumers; ++i) {
+        pthread_create(&cons[i], NULL, consumer_thread, NULL);
+    }
+    for (size_t i = 0; i < producers; ++i) {
+        pthread_create(&prod[i], NULL, producer_thread, NULL);
+    }
+    for (size_t i = 0; i < producers; ++i) {
+        pthread_join(prod[i], NULL);
+    }
+    for (size_t i = 0; i < consumers; ++i) {
+        pthread_join(cons[i], NULL);
+    }
+    clock_gettime(CLOCK_MONOTONIC, &t_end);
+
+    sec = (double)(t_end.tv_sec - t_start.tv_sec) + (double)(t_end.tv_nsec - t_start.tv_nsec) / 1e9;
+    return (double)(records_total * record_size) / sec / 1e6;
+}
+
+int
+main(int argc, char** argv) {
+    uint8_t* data;
+
+    if (argc > 1) {
+        max_threads = strtoul(argv[1], NULL, 0);
+    }
+    if (argc > 2) {
+        total_bytes = strtoul(argv[2], NULL, 0);
+    }
+    if (argc > 3) {
+        record_size = strtoul(argv[3], NULL, 0);
+    }
+    if (argc > 4) {
+        buffer_size = strtoul(argv[4], NULL, 0);
+    }
+    if (max_threads == 0 || record_size == 0 || total_bytes < record_size * max_threads
+        || buffer_size <= record_size || (buffer_size & (buffer_size - 1)) != 0) {
+        printf("Invalid arguments\r\n");
+        return -1;
+    }
+
+    data = malloc(buffer_size);
+    lwrb_init(&rb, data, buffer_size);
+
+    printf("bytes: %lu, record: %lu, buffer: %lu, throughput in MB/s\r\n", (unsigned long)total_bytes,
+           (unsigned long)record_size, (unsigned long)buffer_size);
+    printf("prod \\ cons");
+    for (size_t c = 1; c <= max_threads; ++c) {
+        printf("%10lu", (unsigned long)c);
+    }
+    printf("\r\n");
+    for (size_t p = 1; p <= max_threads; ++p) {
+        printf("%11lu", (unsigned long)p);
+        for (size_t c = 1; c <= max_threads; ++c) {
+            printf("%10.1f", run_one(p, c));
+            fflush(stdout);
+        }
+        printf("\r\n");
+    }
+    free(data);
+    return 0;
+}
@@ -0,0 +1,192 @@
+/**
+ * \file            bench_nt.c
+ * \brief           Large transfer benchmark, regular against non-temporal copy
+ *
+ * Producer thread writes large bursts to 64 MiB buffer. Consumer thread reads small chunks
+ * and for every 8 bytes of data updates a counter in its working set table, random access.
+ * Consumer working set time and cache misses show how much producer copies evict it from the cache.
+ *
+ * On Linux, consumer thread cache misses are read with `perf_event_open`, when permitted.
+ *
+ * Usage: lwrb_bench_nt [total_mib] [working_set_kib] [burst_kib]
+ */
+#include <pthread.h>
+#include <sched.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include "lwrb/lwrb.h"
+
+#if defined(__linux__)
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#define BENCH_PERF 1
+#else
+#define BENCH_PERF 0
+#endif
+
+#define BUFFER_SIZE (64UL * 1024UL * 1024UL)
+#define CHUNK_SIZE  4096
+
+static lwrb_t rb;
+static uint8_t* rb_data;
+static uint8_t* burst;
+static uint32_t* table;
+static size_t total, table_count, burst_size;
+
+static double
+now_sec(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (double)ts.tv_sec + (double)ts.tv_nsec / 1e9;
+}
+
+#if BENCH_PERF
+/* Count cache misses of calling thread only */
+static int
+perf_open_thread(void) {
+    struct perf_event_attr attr;
+
+    memset(&attr, 0x00, sizeof(attr));
+    attr.size = sizeof(attr);
+    attr.type = PERF_TYPE_HARDWARE;
+    attr.config = PERF_COUNT_HW_CACHE_MISSES;
+    attr.disabled = 1;
+    attr.exclude_kernel = 1;
+    attr.exclude_hv = 1;
+    return (int)syscall(SYS_perf_event_open, &attr, 0, -1, -1, 0);
+}
+#endif /* BENCH_PERF */
+
+static void*
+producer_thread(void* arg) {
+    size_t sent = 0;
+
+    (void)arg;
+    while (sent < total) {
+        size_t len = total - sent < burst_size ? total - sent : burst_size;
+        size_t written = lwrb_write(&rb, burst, len);
+        if (written == 0) {
+            sched_yield();
+        }
+        sent += written;
+    }
+    return NULL;
+}
+
+typedef struct {
+    double sec;            /*!< Total consumer time */
+    double ws_sec;         /*!< Time spent in working set updates */
+    long long cache_miss;  /*!< Consumer cache misses, `-1` if not available */
+    uint32_t check;        /*!< Checksum to keep the work */
+} result_t;
+
+static void
+consume(result_t* res) {
+    uint8_t chunk[CHUNK_SIZE];
+    size_t received = 0;
+    int fd = -1;
+
+#if BENCH_PERF
+    fd = perf_open_thread();
+    if (fd >= 0) {
+        ioctl(fd, PERF_EVENT_IOC_RESET, 0);
+        ioctl(fd, PERF_EVENT_IOC_ENABLE, 0);
+    }
+#endif /* BENCH_PERF */
+    res->ws_sec = 0;
+    res->check = 0;
+    res->sec = now_sec();
+    while (received < total) {
+        size_t len = lwrb_read(&rb, chunk, sizeof(chunk));
+        double t;
+
+        if (len == 0) {
+            sched_yield();
+            continue;
+        }
+        received += len;
+
+        t = now_sec();
+        for (size_t i = 0; i + 8 <= len; i += 8) {
+            uint64_t v;
+            memcpy(&v, &chunk[i], sizeof(v));
+            res->check += ++table[(v * 0x9E3779B97F4A7C15ULL >> 32) % table_count];
+        }
+        res->ws_sec += now_sec() - t;
+    }
+    res->sec = now_sec() - res->sec;
+    res->cache_miss = -1;
+#if BENCH_PERF
+    if (fd >= 0) {
+        ioctl(fd, PERF_EVENT_IOC_DISABLE, 0);
+        if (read(fd, &res->cache_miss, sizeof(res->cache_miss)) != sizeof(res->cache_miss)) {
+            res->cache_miss = -1;
+        }
+        close(fd);
+    }
+#endif /* BENCH_PERF */
+}
+
+static void
+run(const char* name, lwrb_sz_t write_threshold, lwrb_sz_t read_threshold) {
+    pthread_t prod;
+    result_t res;
+
+    lwrb_reset(&rb);
+    lwrb_set_nt_threshold(&rb, write_threshold, read_threshold);
+    memset(table, 0x00, table_count * sizeof(*table));
+
+    pthread_create(&prod, NULL, producer_thread, NULL);
+    consume(&res);
+    pthread_join(prod, NULL);
+
+    printf("mode: %s, throughput: %.1f MB/s, working set: %.3f s", name, (double)total / res.sec / 1e6, res.ws_sec);
+    if (res.cache_miss >= 0) {
+        printf(", cache misses: %.2f/KiB", (double)res.cache_miss / ((double)total / 1024.0));
+    }
+    printf(", check: %u\r\n", (unsigned)res.check);
+}
+
+int
+main(int argc, char** argv) {
+    size_t ws_size = 2UL * 1024UL * 1024UL;
+
+    total = 1024UL * 1024UL * 1024UL;
+    burst_size = 1024UL * 1024UL;
+    if (argc > 1) {
+        total = strtoul(argv[1], NULL, 0) * 1024UL * 1024UL;
+    }
+    if (argc > 2) {
+        ws_size = strtoul(argv[2], NULL, 0) * 1024UL;
+    }
+    if (argc > 3) {
+        burst_size = strtoul(argv[3], NULL, 0) * 1024UL;
+    }
+    if (total == 0 || ws_size < sizeof(*table) || burst_size == 0 || burst_size >= BUFFER_SIZE) {
+        printf("Invalid arguments\r\n");
+        return -1;
+    }
+
+    rb_data = malloc(BUFFER_SIZE + 1);
+    burst = malloc(burst_size);
+    table_count = ws_size / sizeof(*table);
+    table = malloc(table_count * sizeof(*table));
+    for (size_t i = 0; i < burst_size; ++i) {
+        burst[i] = (uint8_t)(i * 31 + 7);
+    }
+    memset(rb_data, 0x55, BUFFER_SIZE + 1);
+    lwrb_init(&rb, rb_data, BUFFER_SIZE + 1);
+
+    run("regular", 0, 0);
+    run("nt-write", 64 * 1024, 0);
+    run("nt-write+prefetch", 64 * 1024, CHUNK_SIZE);
+
+    free(table);
+    free(burst);
+    free(rb_data);
+    return 0;
+}
@@ -0,0 +1,148 @@
+/**
+ * \file            bench_pool.c
+ * \brief           Session churn benchmark, buffer pool against `malloc` and \ref lwrb_init
+ *
+ * Keeps a table of live sessions, each with its own buffer of one of few sizes.
+ * Every step closes random session and opens a new one in its place, and sends small message through it.
+ * Then every live buffer is touched once, to show the effect of memory locality.
+ *
+ * Usage: lwrb_bench_pool [sessions] [steps]
+ */
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include "lwrb/lwrb.h"
+
+static const lwrb_sz_t sizes[] = {256, 1024, 4096};
+
+static lwrb_t** sessions;
+static lwrb_pool_t pool;
+static size_t session_count, step_count;
+static uint32_t rnd_state;
+
+static double
+now_sec(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (double)ts.tv_sec + (double)ts.tv_nsec / 1e9;
+}
+
+/* Same random sequence for both allocators */
+static uint32_t
+rnd(void) {
+    rnd_state ^= rnd_state << 13;
+    rnd_state ^= rnd_state >> 17;
+    rnd_state ^= rnd_state << 5;
+    return rnd_state;
+}
+
+static lwrb_t*
+heap_alloc(lwrb_sz_t size) {
+    lwrb_t* buff = malloc(sizeof(*buff));
+    void* data = malloc(size);
+
+    lwrb_init(buff, data, size);
+    return buff;
+}
+
+static void
+heap_free(lwrb_t* buff) {
+    free(buff->buff);
+    free(buff);
+}
+
+static lwrb_t*
+pool_alloc(lwrb_sz_t size) {
+    return lwrb_pool_alloc(&pool, size);
+}
+
+static void
+pool_free(lwrb_t* buff) {
+    lwrb_pool_free(&pool, buff);
+}
+
+/**
+ * \brief           Run churn and scan over all sessions
+ * \return          Checksum of read data
+ */
+static size_t
+run(const char* name, lwrb_t* (*alloc_fn)(lwrb_sz_t), void (*free_fn)(lwrb_t*)) {
+    uint8_t msg[32], tmp[32];
+    double t_open, t_churn, t_scan, t_close;
+    size_t check = 0;
+
+    memset(msg, 0xAA, sizeof(msg));
+    rnd_state = 0x12345678;
+
+    t_open = now_sec();
+    for (size_t i = 0; i < session_count; ++i) {
+        sessions[i] = alloc_fn(sizes[rnd() % (sizeof(sizes) / sizeof(sizes[0]))]);
+    }
+    t_open = now_sec() - t_open;
+
+    t_churn = now_sec();
+    for (size_t i = 0; i < step_count; ++i) {
+        size_t idx = rnd() % session_count;
+
+        free_fn(sessions[idx]);
+        sessions[idx] = alloc_fn(sizes[rnd() % (sizeof(sizes) / sizeof(sizes[0]))]);
+        lwrb_write(sessions[idx], msg, sizeof(msg));
+        check += lwrb_read(sessions[idx], tmp, sizeof(tmp));
+    }
+    t_churn = now_sec() - t_churn;
+
+    t_scan = now_sec();
+    for (size_t i = 0; i < session_count; ++i) {
+        lwrb_write(sessions[i], msg, 8);
+        check += lwrb_get_full(sessions[i]);
+        lwrb_skip(sessions[i], 8);
+    }
+    t_scan = now_sec() - t_scan;
+
+    t_close = now_sec();
+    for (size_t i = 0; i < session_count; ++i) {
+        free_fn(sessions[i]);
+    }
+    t_close = now_sec() - t_close;
+
+    printf("mode: %s, open: %.1f ns, churn: %.1f ns/step, scan: %.1f ns/session, close: %.1f ns, check: %lu\r\n", name,
+           t_open * 1e9 / (double)session_count, t_churn * 1e9 / (double)step_count,
+           t_scan * 1e9 / (double)session_count, t_close * 1e9 / (double)session_count, (unsigned long)check);
+    return check;
+}
+
+int
+main(int argc, char** argv) {
+    size_t arena_size;
+    void* arena;
+
+    session_count = 50000;
+    step_count = 1000000;
+    if (argc > 1) {
+        session_count = strtoul(argv[1], NULL, 0);
+    }
+    if (argc > 2) {
+        step_count = strtoul(argv[2], NULL, 0);
+    }
+    if (session_count == 0) {
+        printf("Invalid arguments\r\n");
+        return -1;
+    }
+    sessions = malloc(session_count * sizeof(*sessions));
+
+    /* Released slots stay in their class, worst case is all sessions of every class at some point */
+    arena_size = LWRB_POOL_ALIGN;
+    for (size_t i = 0; i < sizeof(sizes) / sizeof(sizes[0]); ++i) {
+        arena_size += session_count * (sizeof(lwrb_t) + sizes[i] + LWRB_POOL_ALIGN);
+    }
+    arena = malloc(arena_size);
+    lwrb_pool_init(&pool, arena, arena_size, sizes, sizeof(sizes) / sizeof(sizes[0]));
+
+    run("malloc", heap_alloc, heap_free);
+    run("pool", pool_alloc, pool_free);
+
+    free(arena);
+    free(sessions);
+    return 0;
+}
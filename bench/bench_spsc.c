@@ -0,0 +1,114 @@
+/**
+ * \file            bench_spsc.c
+ * \brief           Two-thread single producer, single consumer throughput benchmark
+ *
+ * Same source is built twice, once with default \ref lwrb_t layout
+ * and once with `LWRB_CACHELINE_ISOLATE` defined, to compare both layouts.
+ *
+ * Usage: lwrb_bench_spsc [total_bytes] [chunk_size] [buffer_size]
+ */
+#include <pthread.h>
+#include <sched.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+#include "lwrb/lwrb.h"
+
+#if defined(LWRB_CACHELINE_ISOLATE)
+#define BENCH_LAYOUT "isolate"
+#else
+#define BENCH_LAYOUT "default"
+#endif
+
+static lwrb_t rb;
+static size_t total_bytes = 256UL * 1024UL * 1024UL;
+static size_t chunk_size = 64;
+static size_t buffer_size = 4096 + 1;
+static uint32_t rx_checksum, tx_checksum;
+
+static void*
+producer_thread(void* arg) {
+    uint8_t* chunk = malloc(chunk_size);
+    size_t sent = 0;
+
+    (void)arg;
+    for (size_t i = 0; i < chunk_size; ++i) {
+        chunk[i] = (uint8_t)i;
+    }
+    while (sent < total_bytes) {
+        size_t len = total_bytes - sent < chunk_size ? total_bytes - sent : chunk_size;
+        size_t written = lwrb_write(&rb, chunk, len);
+        for (size_t i = 0; i < written; ++i) {
+            tx_checksum += chunk[i];
+        }
+        if (written == 0) {
+            sched_yield();
+        }
+        sent += written;
+    }
+    free(chunk);
+    return NULL;
+}
+
+static void*
+consumer_thread(void* arg) {
+    uint8_t* chunk = malloc(chunk_size);
+    size_t received = 0;
+
+    (void)arg;
+    while (received < total_bytes) {
+        size_t read = lwrb_read(&rb, chunk, chunk_size);
+        for (size_t i = 0; i < read; ++i) {
+            rx_checksum += chunk[i];
+        }
+        if (read == 0) {
+            sched_yield();
+        }
+        received += read;
+    }
+    free(chunk);
+    return NULL;
+}
+
+int
+main(int argc, char** argv) {
+    pthread_t prod, cons;
+    struct timespec t_start, t_end;
+    uint8_t* data;
+    double sec;
+
+    if (argc > 1) {
+        total_bytes = strtoul(argv[1], NULL, 0);
+    }
+    if (argc > 2) {
+        chunk_size = strtoul(argv[2], NULL, 0);
+    }
+    if (argc > 3) {
+        buffer_size = strtoul(argv[3], NULL, 0);
+    }
+    if (total_bytes == 0 || chunk_size == 0 || buffer_size < 2) {
+        printf("Invalid arguments\r\n");
+        return -1;
+    }
+
+    data = malloc(buffer_size);
+    lwrb_init(&rb, data, buffer_size);
+
+    clock_gettime(CLOCK_MONOTONIC, &t_start);
+    pthread_create(&cons, NULL, consumer_thread, NULL);
+    pthread_create(&prod, NULL, producer_thread, NULL);
+    pthread_join(prod, NULL);
+    pthread_join(cons, NULL);
+    clock_gettime(CLOCK_MONOTONIC, &t_end);
+
+    sec = (double)(t_end.tv_sec - t_start.tv_sec) + (double)(t_end.tv_nsec - t_start.tv_nsec) / 1e9;
+    printf("layout: %s, sizeof(lwrb_t): %u, bytes: %lu, chunk: %lu, buffer: %lu, time: %.3f s, throughput: %.1f MB/s\r\n",
+           BENCH_LAYOUT, (unsigned)sizeof(lwrb_t), (unsigned long)total_bytes, (unsigned long)chunk_size,
+           (unsigned long)buffer_size, sec, (double)total_bytes / sec / 1e6);
+    free(data);
+    if (rx_checksum != tx_checksum) {
+        printf("Checksum mismatch!\r\n");
+        return -1;
+    }
+    return 0;
+}
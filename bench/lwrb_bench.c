@@ -0,0 +1,331 @@
+/**
+ * \file            lwrb_bench.c
+ * \brief           Throughput benchmark matrix with JSON output
+ *
+ * Measures single-thread and two-thread SPSC throughput of the public API,
+ * for every combination of buffer and chunk size. One JSON object is printed per measurement.
+ *
+ * On Linux, CPU cycles and cache misses are read with `perf_event_open`, when permitted.
+ * Counters are reported as `null` otherwise.
+ *
+ * Usage: lwrb_bench [bytes_per_point] [max_buffer_size]
+ */
+#include <pthread.h>
+#include <sched.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include "lwrb/lwrb.h"
+
+#if defined(__linux__)
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#define BENCH_PERF 1
+#else
+#define BENCH_PERF 0
+#endif
+
+/* Benchmark case function, processes at least `total` bytes and returns exact number of processed bytes */
+typedef size_t (*bench_fn)(size_t total);
+
+typedef struct {
+    const char* name;    /*!< Case name in JSON output */
+    bench_fn fn;         /*!< Case function */
+    uint8_t uses_chunk;  /*!< Set to `1` when case depends on chunk size */
+} bench_case_t;
+
+typedef struct {
+    double sec;            /*!< Elapsed time in seconds */
+    long long cycles;      /*!< CPU cycles, `-1` if not available */
+    long long cache_miss;  /*!< Cache misses, `-1` if not available */
+} bench_result_t;
+
+static lwrb_t rb, rb_dst;
+static uint8_t *rb_data, *rb_dst_data, *chunk;
+static size_t buffer_size, chunk_size;
+static volatile size_t spsc_total;
+
+static int perf_fd_cycles = -1, perf_fd_cache_miss = -1;
+
+/**
+ * \brief           Write and read back chunks, single thread
+ */
+static size_t
+case_write_read(size_t total) {
+    size_t done = 0;
+
+    lwrb_reset(&rb);
+    while (done < total) {
+        lwrb_sz_t len = lwrb_write(&rb, chunk, chunk_size);
+        done += lwrb_read(&rb, chunk, len);
+    }
+    return done;
+}
+
+/**
+ * \brief           Peek chunks at increasing offsets from full buffer
+ */
+static size_t
+case_peek(size_t total) {
+    size_t done = 0, offset = 0, max_offset;
+
+    lwrb_reset(&rb);
+    lwrb_advance(&rb, buffer_size - 1);
+    max_offset = buffer_size - 1 - chunk_size;
+    while (done < total) {
+        done += lwrb_peek(&rb, offset, chunk, chunk_size);
+        offset = offset + chunk_size > max_offset ? 0 : offset + chunk_size;
+    }
+    return done;
+}
+
+/**
+ * \brief           Search full buffer for a needle, that is not present
+ */
+static size_t
+case_find(size_t total) {
+    static const uint8_t needle[] = {0xFF, 0xFE, 0xFD, 0xFC};
+    size_t done = 0;
+    lwrb_sz_t idx;
+
+    lwrb_reset(&rb);
+    lwrb_advance(&rb, buffer_size - 1);
+    while (done < total) {
+        lwrb_find(&rb, needle, sizeof(needle), 0, &idx);
+        done += buffer_size - 1;
+    }
+    return done;
+}
+
+/**
+ * \brief           Move full source buffer to empty destination buffer
+ */
+static size_t
+case_move(size_t total) {
+    size_t done = 0;
+
+    lwrb_reset(&rb);
+    lwrb_reset(&rb_dst);
+    while (done < total) {
+        lwrb_advance(&rb, lwrb_get_free(&rb));
+        done += lwrb_move(&rb_dst, &rb);
+        lwrb_skip(&rb_dst, lwrb_get_full(&rb_dst));
+    }
+    return done;
+}
+
+/**
+ * \brief           Write and read chunks with linear block functions, single thread
+ */
+static size_t
+case_linear(size_t total) {
+    size_t done = 0;
+
+    lwrb_reset(&rb);
+    while (done < total) {
+        lwrb_sz_t len = lwrb_get_linear_block_write_length(&rb);
+        len = len < chunk_size ? len : chunk_size;
+        memcpy(lwrb_get_linear_block_write_address(&rb), chunk, len);
+        lwrb_advance(&rb, len);
+
+        len = lwrb_get_linear_block_read_length(&rb);
+        len = len < chunk_size ? len : chunk_size;
+        memcpy(chunk, lwrb_get_linear_block_read_address(&rb), len);
+        done += lwrb_skip(&rb, len);
+    }
+    return done;
+}
+
+static void*
+spsc_producer_thread(void* arg) {
+    uint8_t* data = malloc(chunk_size);
+    size_t sent = 0;
+
+    (void)arg;
+    memset(data, 0xAA, chunk_size);
+    while (sent < spsc_total) {
+        size_t len = spsc_total - sent < chunk_size ? spsc_total - sent : chunk_size;
+        size_t written = lwrb_write(&rb, data, len);
+        if (written == 0) {
+            sched_yield();
+        }
+        sent += written;
+    }
+    free(data);
+    return NULL;
+}
+
+/**
+ * \brief           Two-thread producer and consumer
+ */
+static size_t
+case_spsc(size_t total) {
+    pthread_t prod;
+    size_t received = 0;
+
+    lwrb_reset(&rb);
+    spsc_total = total;
+    pthread_create(&prod, NULL, spsc_producer_thread, NULL);
+    while (received < total) {
+        size_t read = lwrb_read(&rb, chunk, chunk_size);
+        if (read == 0) {
+            sched_yield();
+        }
+        received += read;
+    }
+    pthread_join(prod, NULL);
+    return received;
+}
+
+static const bench_case_t cases[] = {
+    {"write_read", case_write_read, 1}, {"peek", case_peek, 1}, {"find", case_find, 0},
+    {"move", case_move, 0},             {"linear", case_linear, 1}, {"spsc", case_spsc, 1},
+};
+
+#if BENCH_PERF
+
+static int
+perf_open(uint64_t config) {
+    struct perf_event_attr attr;
+
+    memset(&attr, 0x00, sizeof(attr));
+    attr.size = sizeof(attr);
+    attr.type = PERF_TYPE_HARDWARE;
+    attr.config = config;
+    attr.disabled = 1;
+    attr.inherit = 1; /* Count producer thread of SPSC case too */
+    attr.exclude_kernel = 1;
+    attr.exclude_hv = 1;
+    return (int)syscall(SYS_perf_event_open, &attr, 0, -1, -1, 0);
+}
+
+static void
+perf_start(int fd) {
+    if (fd >= 0) {
+        ioctl(fd, PERF_EVENT_IOC_RESET, 0);
+        ioctl(fd, PERF_EVENT_IOC_ENABLE, 0);
+    }
+}
+
+static long long
+perf_stop(int fd) {
+    long long val = -1;
+
+    if (fd >= 0) {
+        ioctl(fd, PERF_EVENT_IOC_DISABLE, 0);
+        if (read(fd, &val, sizeof(val)) != sizeof(val)) {
+            val = -1;
+        }
+    }
+    return val;
+}
+
+#else
+
+#define perf_start(fd)
+#define perf_stop(fd) (-1LL)
+
+#endif /* BENCH_PERF */
+
+static double
+now_sec(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (double)ts.tv_sec + (double)ts.tv_nsec / 1e9;
+}
+
+/**
+ * \brief           Print counter per given unit as JSON value, or `null` if not available
+ */
+static void
+print_counter(const char* name, long long val, double unit) {
+    if (val < 0) {
+        printf(", \"%s\": null", name);
+    } else {
+        printf(", \"%s\": %.4f", name, (double)val / unit);
+    }
+}
+
+int
+main(int argc, char** argv) {
+    static const size_t buffer_sizes[] = {64, 4096, 256UL * 1024UL, 4UL * 1024UL * 1024UL, 64UL * 1024UL * 1024UL};
+    static const size_t chunk_sizes[] = {16, 256, 4096};
+    size_t bytes_per_point = 64UL * 1024UL * 1024UL, max_buffer_size = 64UL * 1024UL * 1024UL;
+    uint8_t first = 1;
+
+    if (argc > 1) {
+        bytes_per_point = strtoul(argv[1], NULL, 0);
+    }
+    if (argc > 2) {
+        max_buffer_size = strtoul(argv[2], NULL, 0);
+    }
+    if (bytes_per_point == 0) {
+        printf("Invalid arguments\r\n");
+        return -1;
+    }
+
+#if BENCH_PERF
+    perf_fd_cycles = perf_open(PERF_COUNT_HW_CPU_CYCLES);
+    perf_fd_cache_miss = perf_open(PERF_COUNT_HW_CACHE_MISSES);
+#endif /* BENCH_PERF */
+
+    printf("[\n");
+    for (size_t b = 0; b < sizeof(buffer_sizes) / sizeof(buffer_sizes[0]); ++b) {
+        if (buffer_sizes[b] > max_buffer_size) {
+            break;
+        }
+
+        /* Buffer size is 1 byte bigger, to fit complete power of 2 size of data */
+        buffer_size = buffer_sizes[b] + 1;
+        rb_data = malloc(buffer_size);
+        rb_dst_data = malloc(buffer_size);
+        memset(rb_data, 0x55, buffer_size);
+        memset(rb_dst_data, 0x55, buffer_size);
+        lwrb_init(&rb, rb_data, buffer_size);
+        lwrb_init(&rb_dst, rb_dst_data, buffer_size);
+
+        for (size_t c = 0; c < sizeof(cases) / sizeof(cases[0]); ++c) {
+            for (size_t k = 0; k < sizeof(chunk_sizes) / sizeof(chunk_sizes[0]); ++k) {
+                bench_result_t res;
+                size_t done;
+
+                chunk_size = chunk_sizes[k];
+                if (!cases[c].uses_chunk && k > 0) {
+                    break;
+                }
+                if (cases[c].uses_chunk && chunk_size >= buffer_size - 1) {
+                    continue;
+                }
+                chunk = malloc(chunk_size);
+                memset(chunk, 0xAA, chunk_size);
+
+                perf_start(perf_fd_cycles);
+                perf_start(perf_fd_cache_miss);
+                res.sec = now_sec();
+                done = cases[c].fn(bytes_per_point);
+                res.sec = now_sec() - res.sec;
+                res.cycles = perf_stop(perf_fd_cycles);
+                res.cache_miss = perf_stop(perf_fd_cache_miss);
+                free(chunk);
+
+                printf("%s  {\"case\": \"%s\", \"buffer_size\": %lu, \"chunk_size\": %lu, \"bytes\": %lu, "
+                       "\"seconds\": %.6f, \"mb_per_s\": %.1f",
+                       first ? "" : ",\n", cases[c].name, (unsigned long)buffer_sizes[b],
+                       cases[c].uses_chunk ? (unsigned long)chunk_size : 0UL, (unsigned long)done, res.sec,
+                       (double)done / res.sec / 1e6);
+                print_counter("cycles_per_byte", res.cycles, (double)done);
+                print_counter("cache_misses_per_kib", res.cache_miss, (double)done / 1024.0);
+                printf("}");
+                fflush(stdout);
+                first = 0;
+            }
+        }
+        free(rb_data);
+        free(rb_dst_data);
+    }
+    printf("\n]\n");
+    return 0;
+}
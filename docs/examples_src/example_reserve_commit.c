@@ -0,0 +1,31 @@
+/* Declare rb instance & raw data */
+lwrb_t buff;
+uint8_t buff_data[8];
+
+lwrb_iovec_t spans[2];
+size_t len;
+
+/* Initialize buffer, use buff_data as data array */
+lwrb_init(&buff, buff_data, sizeof(buff_data));
+
+/* Use write, read operations, process data */
+/* ... */
+
+/* Reserve up to 6 bytes of free memory, possibly across the end of the buffer */
+/* spans[0] starts at write pointer, spans[1] at the beginning of the buffer */
+if ((len = lwrb_write_reserve(&buff, 6, spans)) == 6) {
+    /* Serialize message directly to buffer memory, first to spans[0], then to spans[1] */
+    serialize_to_spans(spans, len);
+
+    /* Publish complete message with single write pointer update */
+    lwrb_write_commit(&buff, len);
+}
+
+/* Read side: acquire all available data, possibly across the end of the buffer */
+if ((len = lwrb_read_acquire(&buff, lwrb_get_full(&buff), spans)) > 0) {
+    /* Parse data in place, spans[0] first, then spans[1] */
+    len = parse_from_spans(spans, len);
+
+    /* Release parsed bytes with single read pointer update */
+    lwrb_read_release(&buff, len);
+}
@@ -16,6 +16,8 @@ set(LWRB_CUSTOM_INC_DIR ${CMAKE_CURRENT_BINARY_DIR}/lib_inc)
 # Library core sources
 set(lwrb_core_SRCS
     ${CMAKE_CURRENT_LIST_DIR}/src/lwrb/lwrb.c
+    ${CMAKE_CURRENT_LIST_DIR}/src/lwrb/lwrb_pool.c
+    ${CMAKE_CURRENT_LIST_DIR}/src/lwrb/lwrb_seg.c
 )
 
 # Library extended sources
@@ -23,6 +25,20 @@ set(lwrb_ex_SRCS
     ${CMAKE_CURRENT_LIST_DIR}/src/lwrb/lwrb_ex.c
 )
 
+# Library system specific sources, built only for matching system
+set(lwrb_sys_SRCS)
+if(CMAKE_SYSTEM_NAME STREQUAL "Linux")
+    list(APPEND lwrb_sys_SRCS
+        ${CMAKE_CURRENT_LIST_DIR}/src/system/lwrb_mirror_linux.c
+    )
+endif()
+if(UNIX)
+    list(APPEND lwrb_sys_SRCS
+        ${CMAKE_CURRENT_LIST_DIR}/src/system/lwrb_fd_posix.c
+        ${CMAKE_CURRENT_LIST_DIR}/src/system/lwrb_shm_posix.c
+    )
+endif()
+
 # Setup include directories
 set(lwrb_include_DIRS
     ${CMAKE_CURRENT_LIST_DIR}/src/include
@@ -31,7 +47,7 @@ set(lwrb_include_DIRS
 
 # Register library to the system
 add_library(lwrb)
-target_sources(lwrb PRIVATE ${lwrb_core_SRCS})
+target_sources(lwrb PRIVATE ${lwrb_core_SRCS} ${lwrb_sys_SRCS})
 target_include_directories(lwrb PUBLIC ${lwrb_include_DIRS})
 target_compile_options(lwrb PRIVATE ${LWRB_COMPILE_OPTIONS})
 target_compile_definitions(lwrb PRIVATE ${LWRB_COMPILE_DEFINITIONS})
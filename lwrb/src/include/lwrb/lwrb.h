@@ -34,9 +34,28 @@
 #ifndef LWRB_HDR_H
 #define LWRB_HDR_H
 
+/*
+ * Header-only mode builds wait functions in application compilation unit.
+ * They need `syscall` and `clock_gettime`, feature macro must precede the first system header
+ */
+#if defined(LWRB_HEADER_ONLY) && defined(LWRB_WAIT) && !defined(_GNU_SOURCE)
+#define _GNU_SOURCE
+#endif /* defined(LWRB_HEADER_ONLY) && defined(LWRB_WAIT) && !defined(_GNU_SOURCE) */
+
 #include <stddef.h>
 #include <stdint.h>
 #include <string.h>
+#if defined(LWRB_FD)
+#include <sys/types.h>
+#endif /* defined(LWRB_FD) */
+#if !defined(LWRB_DISABLE_ATOMIC)
+#ifdef __cplusplus
+/* C++ has no <stdatomic.h> before C++23, use layout compatible <atomic> types instead */
+#include <atomic>
+#else
+#include <stdatomic.h>
+#endif /* __cplusplus */
+#endif /* !defined(LWRB_DISABLE_ATOMIC) */
 
 #ifdef __cplusplus
 extern "C" {
@@ -48,14 +67,74 @@ extern "C" {
  * \{
  */
 
+/**
+ * \brief           Storage class and attributes of core library functions.
+ *
+ * Empty by default. With `LWRB_HEADER_ONLY` defined, core functions
+ * are defined as `static inline` in every compilation unit, that includes this header,
+ * so that compiler can inline them into application loops
+ */
+#ifndef LWRB_API
+#if defined(LWRB_HEADER_ONLY)
+#define LWRB_API static inline
+#else
+#define LWRB_API
+#endif /* defined(LWRB_HEADER_ONLY) */
+#endif /* LWRB_API */
+
+#if defined(LWRB_MULTI_PRODUCER) && defined(LWRB_DISABLE_ATOMIC)
+#error "LWRB_MULTI_PRODUCER requires atomic operations, LWRB_DISABLE_ATOMIC must not be defined"
+#endif
+#if defined(LWRB_MULTI_CONSUMER) && defined(LWRB_DISABLE_ATOMIC)
+#error "LWRB_MULTI_CONSUMER requires atomic operations, LWRB_DISABLE_ATOMIC must not be defined"
+#endif
+/*
+ * Reservation compare-and-swap relies on pointers, that do not repeat after one buffer cycle.
+ * Pointers wrapping at buffer size allow stale reservation to succeed one cycle later
+ */
+#if (defined(LWRB_MULTI_PRODUCER) || defined(LWRB_MULTI_CONSUMER)) && !defined(LWRB_POW2)
+#error "LWRB_MULTI_PRODUCER and LWRB_MULTI_CONSUMER require free running pointers, LWRB_POW2 must be defined"
+#endif
+
+#if defined(LWRB_WAIT) && defined(LWRB_DISABLE_ATOMIC)
+#error "LWRB_WAIT requires atomic operations, LWRB_DISABLE_ATOMIC must not be defined"
+#endif
+#if defined(LWRB_WAIT) && !defined(__linux__)
+#error "LWRB_WAIT is only supported on Linux"
+#endif
+#if defined(LWRB_LOSSY) && defined(LWRB_DISABLE_ATOMIC)
+#error "LWRB_LOSSY requires atomic operations, LWRB_DISABLE_ATOMIC must not be defined"
+#endif
+#if defined(LWRB_BCAST) && defined(LWRB_DISABLE_ATOMIC)
+#error "LWRB_BCAST requires atomic operations, LWRB_DISABLE_ATOMIC must not be defined"
+#endif
+#if defined(LWRB_SHM) && defined(LWRB_DISABLE_ATOMIC)
+#error "LWRB_SHM requires atomic operations, LWRB_DISABLE_ATOMIC must not be defined"
+#endif
+#if defined(LWRB_HEADER_ONLY) && defined(__cplusplus) && !defined(LWRB_DISABLE_ATOMIC)
+#error "LWRB_HEADER_ONLY with atomic operations is only supported in C compilation units"
+#endif
+
 #if !defined(LWRB_DISABLE_ATOMIC) || __DOXYGEN__
-#include <stdatomic.h>
 
 /**
  * \brief           Atomic type for size variable.
  * Default value is set to be `unsigned 32-bits` type
  */
+#ifdef __cplusplus
+typedef std::atomic_ulong lwrb_sz_atomic_t;
+#else
 typedef atomic_ulong lwrb_sz_atomic_t;
+#endif /* __cplusplus */
+
+/**
+ * \brief           Atomic unsigned integer, used as futex word of blocking wait functions
+ */
+#ifdef __cplusplus
+typedef std::atomic_uint lwrb_atomic_uint_t;
+#else
+typedef atomic_uint lwrb_atomic_uint_t;
+#endif /* __cplusplus */
 
 /**
  * \brief           Size variable for all library operations.
@@ -81,6 +160,10 @@ typedef enum {
     LWRB_EVT_READ,  /*!< Read event */
     LWRB_EVT_WRITE, /*!< Write event */
     LWRB_EVT_RESET, /*!< Reset event */
+#if defined(LWRB_EVT_WATERMARK) || __DOXYGEN__
+    LWRB_EVT_HIGH_WATERMARK, /*!< Number of bytes in buffer rose to high watermark or above */
+    LWRB_EVT_LOW_WATERMARK,  /*!< Number of bytes in buffer dropped to low watermark or below */
+#endif                       /* defined(LWRB_EVT_WATERMARK) || __DOXYGEN__ */
 } lwrb_evt_type_t;
 
 /**
@@ -100,53 +183,557 @@ typedef void (*lwrb_evt_fn)(struct lwrb* buff, lwrb_evt_type_t evt, lwrb_sz_t bp
 #define LWRB_FLAG_READ_ALL  ((uint16_t)0x0001)
 #define LWRB_FLAG_WRITE_ALL ((uint16_t)0x0001)
 
+/**
+ * \brief           Timeout value for \ref lwrb_read_wait and \ref lwrb_write_wait to wait without limit
+ */
+#define LWRB_WAIT_FOREVER ((uint32_t)0xFFFFFFFF)
+
+/**
+ * \brief           Memory block descriptor for vectored read and write operations
+ */
+typedef struct {
+    void* data;    /*!< Pointer to memory block. Entry is skipped when set to `NULL` */
+    lwrb_sz_t len; /*!< Length of memory block in units of bytes */
+} lwrb_iovec_t;
+
+#if defined(LWRB_STATS) || __DOXYGEN__
+
+/**
+ * \brief           Statistics counters of one buffer side, written only by that side.
+ *
+ * Counters are free running and wrap at the maximum value of \ref lwrb_sz_t.
+ * Use \ref lwrb_get_stats to get consistent snapshot
+ */
+typedef struct {
+    lwrb_sz_atomic_t seq_begin;  /*!< Number of started updates */
+    lwrb_sz_atomic_t seq_end;    /*!< Number of finished updates */
+    lwrb_sz_atomic_t bytes;      /*!< Number of bytes written (read) */
+    lwrb_sz_atomic_t short_ops;  /*!< Number of operations, that processed less bytes than requested, but not `0` */
+    lwrb_sz_atomic_t failed_ops; /*!< Number of operations, that processed no bytes */
+    lwrb_sz_atomic_t edges;      /*!< Number of transitions to full (write side) or empty (read side) buffer */
+    lwrb_sz_atomic_t peak;       /*!< Peak number of bytes in the buffer, write side only */
+    lwrb_sz_atomic_t dropped;    /*!< Number of bytes dropped by \ref lwrb_overwrite, write side only */
+} lwrb_stats_side_t;
+
+/**
+ * \brief           Buffer statistics snapshot, filled by \ref lwrb_get_stats
+ */
+typedef struct {
+    lwrb_sz_t bytes_in;      /*!< Total number of bytes written */
+    lwrb_sz_t bytes_out;     /*!< Total number of bytes read or skipped */
+    lwrb_sz_t write_short;   /*!< Number of writes, that wrote less than requested */
+    lwrb_sz_t write_failed;  /*!< Number of writes, that wrote nothing */
+    lwrb_sz_t read_short;    /*!< Number of reads, that read less than requested */
+    lwrb_sz_t read_failed;   /*!< Number of reads, that read nothing */
+    lwrb_sz_t peak_full;     /*!< Peak number of bytes in the buffer */
+    lwrb_sz_t full_count;    /*!< Number of times write made the buffer full */
+    lwrb_sz_t empty_count;   /*!< Number of times read made the buffer empty */
+    lwrb_sz_t overwritten;   /*!< Number of bytes dropped by \ref lwrb_overwrite */
+} lwrb_stats_t;
+
+#endif /* defined(LWRB_STATS) || __DOXYGEN__ */
+
+#if defined(LWRB_CACHELINE_ISOLATE) || defined(LWRB_SHM) || defined(LWRB_STATS) || __DOXYGEN__
+
+/**
+ * \brief           Cache line size in units of bytes, used when `LWRB_CACHELINE_ISOLATE`, `LWRB_SHM`
+ *                  or `LWRB_STATS` is defined.
+ *
+ * Producer owned and consumer owned members of \ref lwrb_t and \ref lwrb_shm_hdr_t are aligned to this value,
+ * so that each side writes only to its own cache line
+ */
+#ifndef LWRB_CACHELINE_SIZE
+#define LWRB_CACHELINE_SIZE 64
+#endif
+
+#ifdef __cplusplus
+#define LWRB_CACHELINE_ALIGN alignas(LWRB_CACHELINE_SIZE)
+#else
+#define LWRB_CACHELINE_ALIGN _Alignas(LWRB_CACHELINE_SIZE)
+#endif
+
+#endif /* defined(LWRB_CACHELINE_ISOLATE) || defined(LWRB_SHM) || defined(LWRB_STATS) || __DOXYGEN__ */
+
+#if defined(LWRB_ELEM) || __DOXYGEN__
+
+/**
+ * \brief           Size of data array in units of bytes, for \ref lwrb_init_elem
+ *                  with `count` elements of `elem_size` bytes each.
+ *
+ * One element slot is kept free, unless `LWRB_POW2` is defined
+ */
+#if defined(LWRB_POW2)
+#define LWRB_ELEM_BUFF_SIZE(elem_size, count) ((elem_size) * (count))
+#else
+#define LWRB_ELEM_BUFF_SIZE(elem_size, count) ((elem_size) * ((count) + 1))
+#endif /* defined(LWRB_POW2) */
+
+#endif /* defined(LWRB_ELEM) || __DOXYGEN__ */
+
 /**
  * \brief           Buffer structure
  */
 typedef struct lwrb {
+#if defined(LWRB_CACHELINE_ISOLATE) || __DOXYGEN__
+    /* Shared, read-mostly part - written only at init time */
+    uint8_t* buff;      /*!< Pointer to buffer data. Buffer is considered initialized when `buff != NULL` and `size > 0` */
+    lwrb_sz_t size;     /*!< Size of buffer data. Size of actual buffer is `1` byte less than value holds,
+                                unless `LWRB_POW2` is defined */
+    lwrb_evt_fn evt_fn; /*!< Pointer to event callback function */
+    void* arg;          /*!< Event custom user argument */
+#if defined(LWRB_EVT_WATERMARK) || __DOXYGEN__
+    lwrb_sz_t evt_low;  /*!< Low watermark for edge-triggered events */
+    lwrb_sz_t evt_high; /*!< High watermark for edge-triggered events. Set to `0` for event on every operation */
+#endif                  /* defined(LWRB_EVT_WATERMARK) || __DOXYGEN__ */
+#if defined(LWRB_MIRROR) || __DOXYGEN__
+    lwrb_sz_t linear_size; /*!< Number of bytes linearly accessible from `buff`.
+                                Equal to `size`, or `2 * size` for mirrored buffer */
+#endif /* defined(LWRB_MIRROR) || __DOXYGEN__ */
+#if defined(LWRB_ELEM) || __DOXYGEN__
+    lwrb_sz_t elem_size; /*!< Size of one element in units of bytes. `1` unless set with \ref lwrb_init_elem */
+#endif                   /* defined(LWRB_ELEM) || __DOXYGEN__ */
+#if defined(LWRB_NT_COPY) || __DOXYGEN__
+    lwrb_sz_t nt_w_threshold; /*!< Minimal write length for non-temporal stores to buffer memory, `0` to disable */
+    lwrb_sz_t nt_r_threshold; /*!< Minimal read length for prefetched non-temporal loads from buffer memory,
+                                    `0` to disable */
+#endif /* defined(LWRB_NT_COPY) || __DOXYGEN__ */
+
+    /* Producer owned part */
+    LWRB_CACHELINE_ALIGN lwrb_sz_atomic_t w_ptr; /*!< Next write pointer.
+                                                    Buffer is considered empty when `r == w` and full when `w == r - 1` */
+    lwrb_sz_t r_ptr_cache; /*!< Producer's private copy of `r_ptr`.
+                                Reloaded only when it does not show enough free memory */
+#if defined(LWRB_RESIZE) || __DOXYGEN__
+    lwrb_sz_t peak;     /*!< Highest number of bytes in the buffer after write, since last \ref lwrb_resize_auto */
+    uint8_t mem_alloc;  /*!< Set when buffer memory is allocated by `LWRB_RESIZE_ALLOC` hook
+                             and may be released by the library */
+#endif                  /* defined(LWRB_RESIZE) || __DOXYGEN__ */
+#if defined(LWRB_LOSSY) || __DOXYGEN__
+    lwrb_sz_atomic_t w_head; /*!< End of data being written by lossy write.
+                                Memory of positions before `w_head - size` may already be overwritten */
+#endif /* defined(LWRB_LOSSY) || __DOXYGEN__ */
+#if defined(LWRB_MULTI_PRODUCER) || __DOXYGEN__
+    lwrb_sz_atomic_t w_rsv; /*!< Next write reservation pointer, used by multi-producer write.
+                                Memory between `w` and `w_rsv` is reserved by producers and not yet published */
+#endif /* defined(LWRB_MULTI_PRODUCER) || __DOXYGEN__ */
+#if defined(LWRB_WAIT) || __DOXYGEN__
+    lwrb_atomic_uint_t w_seq;  /*!< Futex word for readers waiting for data. Incremented on write, when `r_wait > 0` */
+    lwrb_atomic_uint_t w_wait; /*!< Number of writers parked on `r_seq` */
+#endif                  /* defined(LWRB_WAIT) || __DOXYGEN__ */
+#if defined(LWRB_STATS) || __DOXYGEN__
+    LWRB_CACHELINE_ALIGN lwrb_stats_side_t w_stats; /*!< Write side statistics, on its own cache line */
+#endif /* defined(LWRB_STATS) || __DOXYGEN__ */
+
+    /* Consumer owned part */
+    LWRB_CACHELINE_ALIGN lwrb_sz_atomic_t r_ptr; /*!< Next read pointer.
+                                                    Buffer is considered empty when `r == w` and full when `w == r - 1` */
+    lwrb_sz_t w_ptr_cache; /*!< Consumer's private copy of `w_ptr`.
+                                Reloaded only when it does not show enough data to read */
+#if defined(LWRB_MULTI_CONSUMER) || __DOXYGEN__
+    lwrb_sz_atomic_t r_rsv; /*!< Next read reservation pointer, used by multi-consumer read.
+                                Memory between `r` and `r_rsv` is claimed by consumers and not yet released */
+#endif /* defined(LWRB_MULTI_CONSUMER) || __DOXYGEN__ */
+#if defined(LWRB_WAIT) || __DOXYGEN__
+    lwrb_atomic_uint_t r_seq;  /*!< Futex word for writers waiting for free memory. Incremented on read, when `w_wait > 0` */
+    lwrb_atomic_uint_t r_wait; /*!< Number of readers parked on `w_seq` */
+#endif                  /* defined(LWRB_WAIT) || __DOXYGEN__ */
+#if defined(LWRB_STATS) || __DOXYGEN__
+    LWRB_CACHELINE_ALIGN lwrb_stats_side_t r_stats; /*!< Read side statistics, on its own cache line */
+#endif /* defined(LWRB_STATS) || __DOXYGEN__ */
+#else
     uint8_t* buff;  /*!< Pointer to buffer data. Buffer is considered initialized when `buff != NULL` and `size > 0` */
-    lwrb_sz_t size; /*!< Size of buffer data. Size of actual buffer is `1` byte less than value holds */
+    lwrb_sz_t size; /*!< Size of buffer data. Size of actual buffer is `1` byte less than value holds,
+                        unless `LWRB_POW2` is defined */
     lwrb_sz_atomic_t r_ptr; /*!< Next read pointer.
                                 Buffer is considered empty when `r == w` and full when `w == r - 1` */
+#if defined(LWRB_MULTI_CONSUMER)
+    lwrb_sz_atomic_t r_rsv; /*!< Next read reservation pointer, used by multi-consumer read.
+                                Memory between `r` and `r_rsv` is claimed by consumers and not yet released */
+#endif                      /* defined(LWRB_MULTI_CONSUMER) */
     lwrb_sz_atomic_t w_ptr; /*!< Next write pointer.
                                 Buffer is considered empty when `r == w` and full when `w == r - 1` */
+#if defined(LWRB_LOSSY)
+    lwrb_sz_atomic_t w_head; /*!< End of data being written by lossy write.
+                                Memory of positions before `w_head - size` may already be overwritten */
+#endif /* defined(LWRB_LOSSY) */
+#if defined(LWRB_MULTI_PRODUCER)
+    lwrb_sz_atomic_t w_rsv; /*!< Next write reservation pointer, used by multi-producer write.
+                                Memory between `w` and `w_rsv` is reserved by producers and not yet published */
+#endif                      /* defined(LWRB_MULTI_PRODUCER) */
     lwrb_evt_fn evt_fn;     /*!< Pointer to event callback function */
     void* arg;              /*!< Event custom user argument */
+#if defined(LWRB_EVT_WATERMARK)
+    lwrb_sz_t evt_low;  /*!< Low watermark for edge-triggered events */
+    lwrb_sz_t evt_high; /*!< High watermark for edge-triggered events. Set to `0` for event on every operation */
+#endif                  /* defined(LWRB_EVT_WATERMARK) */
+#if defined(LWRB_MIRROR)
+    lwrb_sz_t linear_size; /*!< Number of bytes linearly accessible from `buff`.
+                                Equal to `size`, or `2 * size` for mirrored buffer */
+#endif /* defined(LWRB_MIRROR) */
+#if defined(LWRB_ELEM)
+    lwrb_sz_t elem_size; /*!< Size of one element in units of bytes. `1` unless set with \ref lwrb_init_elem */
+#endif                   /* defined(LWRB_ELEM) */
+#if defined(LWRB_NT_COPY)
+    lwrb_sz_t nt_w_threshold; /*!< Minimal write length for non-temporal stores to buffer memory, `0` to disable */
+    lwrb_sz_t nt_r_threshold; /*!< Minimal read length for prefetched non-temporal loads from buffer memory,
+                                    `0` to disable */
+#endif /* defined(LWRB_NT_COPY) */
+#if defined(LWRB_RESIZE)
+    lwrb_sz_t peak;     /*!< Highest number of bytes in the buffer after write, since last \ref lwrb_resize_auto */
+    uint8_t mem_alloc;  /*!< Set when buffer memory is allocated by `LWRB_RESIZE_ALLOC` hook */
+#endif                  /* defined(LWRB_RESIZE) */
+#if defined(LWRB_WAIT)
+    lwrb_atomic_uint_t w_seq;  /*!< Futex word for readers waiting for data. Incremented on write, when `r_wait > 0` */
+    lwrb_atomic_uint_t r_wait; /*!< Number of readers parked on `w_seq` */
+    lwrb_atomic_uint_t r_seq;  /*!< Futex word for writers waiting for free memory. Incremented on read, when `w_wait > 0` */
+    lwrb_atomic_uint_t w_wait; /*!< Number of writers parked on `r_seq` */
+#endif                  /* defined(LWRB_WAIT) */
+#if defined(LWRB_STATS)
+    /* Each side writes its statistics on its own cache line */
+    LWRB_CACHELINE_ALIGN lwrb_stats_side_t w_stats; /*!< Write side statistics */
+    LWRB_CACHELINE_ALIGN lwrb_stats_side_t r_stats; /*!< Read side statistics */
+#endif /* defined(LWRB_STATS) */
+#endif /* !defined(LWRB_CACHELINE_ISOLATE) */
 } lwrb_t;
 
-uint8_t lwrb_init(lwrb_t* buff, void* buffdata, lwrb_sz_t size);
-uint8_t lwrb_is_ready(lwrb_t* buff);
-void lwrb_free(lwrb_t* buff);
-void lwrb_reset(lwrb_t* buff);
-void lwrb_set_evt_fn(lwrb_t* buff, lwrb_evt_fn fn);
-void lwrb_set_arg(lwrb_t* buff, void* arg);
-void* lwrb_get_arg(lwrb_t* buff);
+#if defined(LWRB_SHM) || __DOXYGEN__
+
+/**
+ * \brief           Magic value at the beginning of shared memory buffer
+ */
+#define LWRB_SHM_MAGIC ((uint32_t)0x4C575242)
+
+/**
+ * \brief           Version of shared memory buffer layout
+ */
+#define LWRB_SHM_VERSION ((uint32_t)1)
+
+/**
+ * \brief           Header of shared memory buffer, followed by the data area.
+ *
+ * Header holds no pointers, only offsets and indices, hence memory can be mapped
+ * at different address in each process
+ */
+typedef struct {
+    uint32_t magic;        /*!< Set to \ref LWRB_SHM_MAGIC, when header is initialized */
+    uint32_t version;      /*!< Layout version, \ref LWRB_SHM_VERSION */
+    uint32_t sz_size;      /*!< Size of \ref lwrb_sz_t type in creating process */
+    uint32_t reserved;     /*!< Reserved, set to `0` */
+    lwrb_sz_t size;        /*!< Size of data area in units of bytes, power of `2` */
+    lwrb_sz_t data_offset; /*!< Offset of data area from the beginning of the header */
+    LWRB_CACHELINE_ALIGN lwrb_sz_atomic_t w_ptr; /*!< Free running write index, written by producer only */
+    LWRB_CACHELINE_ALIGN lwrb_sz_atomic_t r_ptr; /*!< Free running read index, written by consumer only */
+} lwrb_shm_hdr_t;
+
+/**
+ * \brief           Size of memory in units of bytes, needed for shared memory buffer with `size` bytes of data
+ */
+#define LWRB_SHM_MEM_SIZE(size) (sizeof(lwrb_shm_hdr_t) + (size))
+
+/**
+ * \brief           Process local handle of shared memory buffer
+ */
+typedef struct {
+    lwrb_shm_hdr_t* hdr; /*!< Header in shared memory, mapped in this process */
+    uint8_t* data;       /*!< Data area, mapped in this process */
+    lwrb_sz_t size;      /*!< Size of data area, validated copy of header value. Other process cannot change it */
+    size_t map_size;     /*!< Size of mapping created by \ref lwrb_shm_create or \ref lwrb_shm_attach, `0` otherwise */
+} lwrb_shm_t;
+
+#endif /* defined(LWRB_SHM) || __DOXYGEN__ */
+
+#if defined(LWRB_POOL) || __DOXYGEN__
+
+/**
+ * \brief           Maximum number of size classes in buffer pool
+ */
+#ifndef LWRB_POOL_MAX_CLASSES
+#define LWRB_POOL_MAX_CLASSES 8
+#endif
+
+/**
+ * \brief           Alignment of pool slots in units of bytes, power of `2`.
+ *
+ * Each slot holds buffer handle, immediately followed by its data,
+ * and starts at this alignment, cache line size by default.
+ * Alignment of \ref lwrb_t is used instead, when it is larger
+ */
+#ifndef LWRB_POOL_ALIGN
+#define LWRB_POOL_ALIGN 64
+#endif
+
+/**
+ * \brief           Size class of buffer pool
+ */
+typedef struct {
+    lwrb_sz_t size;   /*!< Buffer data size of this class, as passed to \ref lwrb_init */
+    size_t slot_size; /*!< Size of one slot, handle and data, rounded up to slot alignment */
+    void* free_list;  /*!< Head of list of released slots */
+    size_t used;      /*!< Number of allocated buffers */
+} lwrb_pool_class_t;
+
+/**
+ * \brief           Pool of buffers of few size classes, carved out of application provided arenas
+ * \note            Not thread safe. Allocate and release buffers from one thread or under one lock.
+ *                  Allocated buffers are regular \ref lwrb_t instances, with thread safety of the core API
+ */
+typedef struct {
+    lwrb_pool_class_t classes[LWRB_POOL_MAX_CLASSES]; /*!< Size classes, in ascending size order */
+    size_t class_count;                               /*!< Number of used entries in `classes` */
+    uint8_t* arena_pos;                               /*!< Next unused byte of current arena */
+    uint8_t* arena_end;                               /*!< End of current arena */
+} lwrb_pool_t;
+
+#endif /* defined(LWRB_POOL) || __DOXYGEN__ */
+
+#if defined(LWRB_SEG) || __DOXYGEN__
+
+/**
+ * \brief           Chunk of segmented buffer, header is immediately followed by chunk data
+ */
+typedef struct lwrb_seg_chunk {
+    struct lwrb_seg_chunk* next; /*!< Next chunk in the buffer or in the pool free list */
+} lwrb_seg_chunk_t;
+
+/**
+ * \brief           Pool of equally sized chunks, shared by segmented buffers
+ */
+typedef struct {
+    lwrb_seg_chunk_t* free_list; /*!< List of unused chunks */
+    lwrb_sz_t chunk_size;        /*!< Data size of one chunk in units of bytes */
+    size_t slot_size;            /*!< Size of chunk header and data, rounded up to pointer alignment */
+    size_t total;                /*!< Number of all chunks */
+    size_t free;                 /*!< Number of unused chunks */
+} lwrb_seg_pool_t;
+
+/**
+ * \brief           Segmented buffer, linked sequence of chunks taken from \ref lwrb_seg_pool_t on demand.
+ *
+ * Single producer and single consumer may access the buffer concurrently, as with \ref lwrb_t.
+ * Only producer takes chunks from the pool and returns consumed chunks to it
+ * \note            Pool is accessed by write side functions. Producers of all buffers, that share one pool,
+ *                  must run in one thread or under one lock
+ */
+typedef struct {
+    lwrb_seg_pool_t* pool; /*!< Pool to take chunks from */
+    lwrb_sz_t max_size;    /*!< Maximal number of bytes in the buffer, `0` for pool limit only */
+
+    /* Producer owned part */
+    lwrb_seg_chunk_t* tail; /*!< Chunk to write to, `NULL` when buffer holds no chunk */
+    lwrb_seg_chunk_t* rel;  /*!< Oldest chunk, not yet returned to the pool */
+    lwrb_sz_t rel_start;    /*!< Value of `w_cnt` at the beginning of `rel` chunk */
+    lwrb_sz_t w_off;        /*!< Write offset in `tail` chunk */
+    lwrb_sz_atomic_t w_cnt; /*!< Number of bytes written, free running */
+
+    /* Consumer owned part */
+    lwrb_seg_chunk_t* head; /*!< Chunk to read from, set by producer with the first chunk */
+    lwrb_sz_t r_off;        /*!< Read offset in `head` chunk. Equal to chunk size, when next chunk is not used yet */
+    lwrb_sz_atomic_t r_cnt; /*!< Number of bytes read, free running */
+} lwrb_seg_t;
+
+#endif /* defined(LWRB_SEG) || __DOXYGEN__ */
+
+#if defined(LWRB_BCAST) || __DOXYGEN__
+
+/**
+ * \brief           Maximum number of readers of broadcast buffer
+ */
+#define LWRB_BCAST_MAX_READERS 32
+
+/**
+ * \brief           Broadcast buffer, with single writer and many independent readers.
+ *
+ * Every reader is regular \ref lwrb_t handle on the same buffer memory, with its own read pointer.
+ * Writer publishes new write pointer to all active readers
+ */
+typedef struct {
+    lwrb_t buff;     /*!< Writer side buffer. Its read pointer follows the slowest active reader */
+    lwrb_t* readers; /*!< Array of reader handles */
+    size_t count;    /*!< Number of entries in `readers` array */
+    uint8_t drop_laggards;       /*!< Set to `1` to detach readers, that do not have enough free memory for write */
+    lwrb_sz_atomic_t active;     /*!< Bit mask of active readers. Modified by writer only */
+    lwrb_sz_atomic_t attach_req; /*!< Bit mask of readers, that requested to be attached again */
+} lwrb_bcast_t;
+
+#endif /* defined(LWRB_BCAST) || __DOXYGEN__ */
+
+LWRB_API uint8_t lwrb_init(lwrb_t* buff, void* buffdata, lwrb_sz_t size);
+LWRB_API uint8_t lwrb_is_ready(lwrb_t* buff);
+LWRB_API void lwrb_free(lwrb_t* buff);
+LWRB_API void lwrb_reset(lwrb_t* buff);
+LWRB_API void lwrb_set_evt_fn(lwrb_t* buff, lwrb_evt_fn fn);
+LWRB_API void lwrb_set_arg(lwrb_t* buff, void* arg);
+LWRB_API void* lwrb_get_arg(lwrb_t* buff);
+#if defined(LWRB_EVT_WATERMARK) || __DOXYGEN__
+LWRB_API uint8_t lwrb_set_evt_watermarks(lwrb_t* buff, lwrb_sz_t low, lwrb_sz_t high);
+#endif /* defined(LWRB_EVT_WATERMARK) || __DOXYGEN__ */
 
 /* Read/Write functions */
-lwrb_sz_t lwrb_write(lwrb_t* buff, const void* data, lwrb_sz_t btw);
-lwrb_sz_t lwrb_read(lwrb_t* buff, void* data, lwrb_sz_t btr);
-lwrb_sz_t lwrb_peek(const lwrb_t* buff, lwrb_sz_t skip_count, void* data, lwrb_sz_t btp);
+LWRB_API lwrb_sz_t lwrb_write(lwrb_t* buff, const void* data, lwrb_sz_t btw);
+LWRB_API lwrb_sz_t lwrb_read(lwrb_t* buff, void* data, lwrb_sz_t btr);
+LWRB_API lwrb_sz_t lwrb_peek(const lwrb_t* buff, lwrb_sz_t skip_count, void* data, lwrb_sz_t btp);
 
 /* Extended read/write functions */
-uint8_t lwrb_write_ex(lwrb_t* buff, const void* data, lwrb_sz_t btw, lwrb_sz_t* bwritten, uint16_t flags);
-uint8_t lwrb_read_ex(lwrb_t* buff, void* data, lwrb_sz_t btr, lwrb_sz_t* bread, uint16_t flags);
+LWRB_API uint8_t lwrb_write_ex(lwrb_t* buff, const void* data, lwrb_sz_t btw, lwrb_sz_t* bwritten, uint16_t flags);
+LWRB_API uint8_t lwrb_read_ex(lwrb_t* buff, void* data, lwrb_sz_t btr, lwrb_sz_t* bread, uint16_t flags);
+
+/* Vectored read/write functions */
+LWRB_API lwrb_sz_t lwrb_writev(lwrb_t* buff, const lwrb_iovec_t* iov, size_t iovcnt);
+LWRB_API uint8_t lwrb_writev_ex(lwrb_t* buff, const lwrb_iovec_t* iov, size_t iovcnt, lwrb_sz_t* bwritten, uint16_t flags);
+LWRB_API lwrb_sz_t lwrb_readv(lwrb_t* buff, const lwrb_iovec_t* iov, size_t iovcnt);
+LWRB_API uint8_t lwrb_readv_ex(lwrb_t* buff, const lwrb_iovec_t* iov, size_t iovcnt, lwrb_sz_t* bread, uint16_t flags);
+
+/* Delimiter-framed read function */
+LWRB_API lwrb_sz_t lwrb_read_until(lwrb_t* buff, uint8_t delim, void* data, lwrb_sz_t btr);
+
+/* Length-prefixed message (record) functions */
+LWRB_API uint8_t lwrb_msg_write(lwrb_t* buff, const void* data, lwrb_sz_t len);
+LWRB_API uint8_t lwrb_msg_peek_len(const lwrb_t* buff, lwrb_sz_t* len);
+LWRB_API lwrb_sz_t lwrb_msg_read(lwrb_t* buff, void* data, lwrb_sz_t btr);
+LWRB_API lwrb_sz_t lwrb_msg_skip(lwrb_t* buff);
+LWRB_API size_t lwrb_msg_read_batch(lwrb_t* buff, void* data, lwrb_sz_t btr, lwrb_sz_t* lens, size_t max_msgs);
+
+#if defined(LWRB_MULTI_PRODUCER) || __DOXYGEN__
+/* Multi-producer write functions */
+LWRB_API lwrb_sz_t lwrb_write_mp(lwrb_t* buff, const void* data, lwrb_sz_t btw);
+LWRB_API uint8_t lwrb_write_mp_ex(lwrb_t* buff, const void* data, lwrb_sz_t btw, lwrb_sz_t* bwritten, uint16_t flags);
+#endif /* defined(LWRB_MULTI_PRODUCER) || __DOXYGEN__ */
+
+#if defined(LWRB_MULTI_CONSUMER) || __DOXYGEN__
+/* Multi-consumer read functions */
+LWRB_API lwrb_sz_t lwrb_read_mc(lwrb_t* buff, void* data, lwrb_sz_t btr);
+LWRB_API uint8_t lwrb_read_mc_ex(lwrb_t* buff, void* data, lwrb_sz_t btr, lwrb_sz_t* bread, uint16_t flags);
+#endif /* defined(LWRB_MULTI_CONSUMER) || __DOXYGEN__ */
 
 /* Buffer size information */
-lwrb_sz_t lwrb_get_free(const lwrb_t* buff);
-lwrb_sz_t lwrb_get_full(const lwrb_t* buff);
+LWRB_API lwrb_sz_t lwrb_get_free(const lwrb_t* buff);
+LWRB_API lwrb_sz_t lwrb_get_full(const lwrb_t* buff);
+
+#if defined(LWRB_STATS) || __DOXYGEN__
+/* Statistics */
+LWRB_API uint8_t lwrb_get_stats(const lwrb_t* buff, lwrb_stats_t* stats);
+#endif /* defined(LWRB_STATS) || __DOXYGEN__ */
 
 /* Read data block management */
-void* lwrb_get_linear_block_read_address(const lwrb_t* buff);
-lwrb_sz_t lwrb_get_linear_block_read_length(const lwrb_t* buff);
-lwrb_sz_t lwrb_skip(lwrb_t* buff, lwrb_sz_t len);
+LWRB_API void* lwrb_get_linear_block_read_address(const lwrb_t* buff);
+LWRB_API lwrb_sz_t lwrb_get_linear_block_read_length(const lwrb_t* buff);
+LWRB_API lwrb_sz_t lwrb_skip(lwrb_t* buff, lwrb_sz_t len);
+LWRB_API lwrb_sz_t lwrb_read_acquire(lwrb_t* buff, lwrb_sz_t btr, lwrb_iovec_t* spans);
+LWRB_API lwrb_sz_t lwrb_read_release(lwrb_t* buff, lwrb_sz_t len);
 
 /* Write data block management */
-void* lwrb_get_linear_block_write_address(const lwrb_t* buff);
-lwrb_sz_t lwrb_get_linear_block_write_length(const lwrb_t* buff);
-lwrb_sz_t lwrb_advance(lwrb_t* buff, lwrb_sz_t len);
+LWRB_API void* lwrb_get_linear_block_write_address(const lwrb_t* buff);
+LWRB_API lwrb_sz_t lwrb_get_linear_block_write_length(const lwrb_t* buff);
+LWRB_API lwrb_sz_t lwrb_advance(lwrb_t* buff, lwrb_sz_t len);
+LWRB_API lwrb_sz_t lwrb_write_reserve(lwrb_t* buff, lwrb_sz_t btw, lwrb_iovec_t* spans);
+LWRB_API lwrb_sz_t lwrb_write_commit(lwrb_t* buff, lwrb_sz_t len);
+
+#if defined(LWRB_BCAST) || __DOXYGEN__
+/* Broadcast buffer, data is written once for many readers */
+LWRB_API uint8_t lwrb_bcast_init(lwrb_bcast_t* bc, void* buffdata, lwrb_sz_t size, lwrb_t* readers, size_t count);
+LWRB_API void lwrb_bcast_set_drop_laggards(lwrb_bcast_t* bc, uint8_t drop);
+LWRB_API lwrb_sz_t lwrb_bcast_write(lwrb_bcast_t* bc, const void* data, lwrb_sz_t btw);
+LWRB_API uint8_t lwrb_bcast_write_ex(lwrb_bcast_t* bc, const void* data, lwrb_sz_t btw, lwrb_sz_t* bwritten,
+                                     uint16_t flags);
+LWRB_API lwrb_sz_t lwrb_bcast_get_free(const lwrb_bcast_t* bc);
+LWRB_API uint8_t lwrb_bcast_is_active(const lwrb_bcast_t* bc, size_t idx);
+LWRB_API uint8_t lwrb_bcast_attach(lwrb_bcast_t* bc, size_t idx);
+#endif /* defined(LWRB_BCAST) || __DOXYGEN__ */
+
+#if defined(LWRB_LOSSY) || __DOXYGEN__
+/* Lossy mode, writer never waits for reader */
+LWRB_API uint8_t lwrb_init_lossy(lwrb_t* buff, void* buffdata, lwrb_sz_t size);
+LWRB_API lwrb_sz_t lwrb_write_lossy(lwrb_t* buff, const void* data, lwrb_sz_t btw);
+LWRB_API lwrb_sz_t lwrb_read_lossy(lwrb_t* buff, void* data, lwrb_sz_t btr, lwrb_sz_t* lost);
+#endif /* defined(LWRB_LOSSY) || __DOXYGEN__ */
+
+#if defined(LWRB_ELEM) || __DOXYGEN__
+/* Fixed-size element access */
+LWRB_API uint8_t lwrb_init_elem(lwrb_t* buff, void* buffdata, lwrb_sz_t elem_size, lwrb_sz_t count);
+LWRB_API lwrb_sz_t lwrb_write_n(lwrb_t* buff, const void* data, lwrb_sz_t count);
+LWRB_API lwrb_sz_t lwrb_read_n(lwrb_t* buff, void* data, lwrb_sz_t count);
+LWRB_API lwrb_sz_t lwrb_peek_n(const lwrb_t* buff, lwrb_sz_t skip_count, void* data, lwrb_sz_t count);
+LWRB_API lwrb_sz_t lwrb_get_free_n(const lwrb_t* buff);
+LWRB_API lwrb_sz_t lwrb_get_full_n(const lwrb_t* buff);
+#endif /* defined(LWRB_ELEM) || __DOXYGEN__ */
+
+#if defined(LWRB_NT_COPY) || __DOXYGEN__
+/* Non-temporal copy of large transfers */
+LWRB_API uint8_t lwrb_set_nt_threshold(lwrb_t* buff, lwrb_sz_t write_threshold, lwrb_sz_t read_threshold);
+#endif /* defined(LWRB_NT_COPY) || __DOXYGEN__ */
+
+#if defined(LWRB_WAIT) || __DOXYGEN__
+/* Blocking wait functions, system specific */
+LWRB_API uint8_t lwrb_read_wait(lwrb_t* buff, lwrb_sz_t btr, uint32_t timeout_ms);
+LWRB_API uint8_t lwrb_write_wait(lwrb_t* buff, lwrb_sz_t btw, uint32_t timeout_ms);
+#endif /* defined(LWRB_WAIT) || __DOXYGEN__ */
+
+#if defined(LWRB_FD) || __DOXYGEN__
+/* File descriptor I/O, system specific */
+ssize_t lwrb_write_from_fd(lwrb_t* buff, int fd, lwrb_sz_t btw);
+ssize_t lwrb_read_to_fd(lwrb_t* buff, int fd, lwrb_sz_t btr);
+#endif /* defined(LWRB_FD) || __DOXYGEN__ */
+
+#if defined(LWRB_POOL) || __DOXYGEN__
+/* Buffer pool */
+uint8_t lwrb_pool_init(lwrb_pool_t* pool, void* arena, size_t arena_size, const lwrb_sz_t* sizes, size_t count);
+uint8_t lwrb_pool_add_arena(lwrb_pool_t* pool, void* arena, size_t arena_size);
+lwrb_t* lwrb_pool_alloc(lwrb_pool_t* pool, lwrb_sz_t size);
+uint8_t lwrb_pool_free(lwrb_pool_t* pool, lwrb_t* buff);
+#endif /* defined(LWRB_POOL) || __DOXYGEN__ */
+
+#if defined(LWRB_SEG) || __DOXYGEN__
+/* Segmented buffer */
+uint8_t lwrb_seg_pool_init(lwrb_seg_pool_t* pool, void* mem, size_t mem_size, lwrb_sz_t chunk_size);
+size_t lwrb_seg_pool_get_free(const lwrb_seg_pool_t* pool);
+uint8_t lwrb_seg_init(lwrb_seg_t* buff, lwrb_seg_pool_t* pool, lwrb_sz_t max_size);
+void lwrb_seg_reset(lwrb_seg_t* buff);
+lwrb_sz_t lwrb_seg_write(lwrb_seg_t* buff, const void* data, lwrb_sz_t btw);
+lwrb_sz_t lwrb_seg_read(lwrb_seg_t* buff, void* data, lwrb_sz_t btr);
+lwrb_sz_t lwrb_seg_peek(const lwrb_seg_t* buff, lwrb_sz_t skip_count, void* data, lwrb_sz_t btp);
+lwrb_sz_t lwrb_seg_skip(lwrb_seg_t* buff, lwrb_sz_t len);
+lwrb_sz_t lwrb_seg_advance(lwrb_seg_t* buff, lwrb_sz_t len);
+lwrb_sz_t lwrb_seg_reserve(lwrb_seg_t* buff);
+lwrb_sz_t lwrb_seg_get_free(const lwrb_seg_t* buff);
+lwrb_sz_t lwrb_seg_get_full(const lwrb_seg_t* buff);
+void* lwrb_seg_get_linear_block_read_address(const lwrb_seg_t* buff);
+lwrb_sz_t lwrb_seg_get_linear_block_read_length(const lwrb_seg_t* buff);
+void* lwrb_seg_get_linear_block_write_address(const lwrb_seg_t* buff);
+lwrb_sz_t lwrb_seg_get_linear_block_write_length(const lwrb_seg_t* buff);
+#endif /* defined(LWRB_SEG) || __DOXYGEN__ */
+
+#if defined(LWRB_RESIZE) || __DOXYGEN__
+/* Runtime resize */
+LWRB_API uint8_t lwrb_resize(lwrb_t* buff, void* new_data, lwrb_sz_t new_size, void** old_data);
+LWRB_API uint8_t lwrb_init_alloc(lwrb_t* buff, lwrb_sz_t size);
+LWRB_API uint8_t lwrb_resize_alloc(lwrb_t* buff, lwrb_sz_t new_size);
+LWRB_API void lwrb_free_alloc(lwrb_t* buff);
+LWRB_API lwrb_sz_t lwrb_resize_auto(lwrb_t* buff, lwrb_sz_t min_size, lwrb_sz_t max_size);
+#endif /* defined(LWRB_RESIZE) || __DOXYGEN__ */
+
+#if defined(LWRB_SHM) || __DOXYGEN__
+/* Shared memory buffer between processes */
+uint8_t lwrb_shm_format(lwrb_shm_t* shm, void* mem, lwrb_sz_t size);
+uint8_t lwrb_shm_bind(lwrb_shm_t* shm, void* mem, size_t mem_size);
+uint8_t lwrb_shm_create(lwrb_shm_t* shm, const char* name, lwrb_sz_t size);
+uint8_t lwrb_shm_attach(lwrb_shm_t* shm, const char* name);
+void lwrb_shm_close(lwrb_shm_t* shm);
+uint8_t lwrb_shm_unlink(const char* name);
+lwrb_sz_t lwrb_shm_write(lwrb_shm_t* shm, const void* data, lwrb_sz_t btw);
+lwrb_sz_t lwrb_shm_read(lwrb_shm_t* shm, void* data, lwrb_sz_t btr);
+lwrb_sz_t lwrb_shm_get_free(const lwrb_shm_t* shm);
+lwrb_sz_t lwrb_shm_get_full(const lwrb_shm_t* shm);
+#endif /* defined(LWRB_SHM) || __DOXYGEN__ */
+
+#if defined(LWRB_MIRROR) || __DOXYGEN__
+/* Mirrored buffer, system specific */
+uint8_t lwrb_init_mirror(lwrb_t* buff, lwrb_sz_t size);
+void lwrb_free_mirror(lwrb_t* buff);
+#endif /* defined(LWRB_MIRROR) || __DOXYGEN__ */
 
 /* Search in buffer */
-uint8_t lwrb_find(const lwrb_t* buff, const void* bts, lwrb_sz_t len, lwrb_sz_t start_offset, lwrb_sz_t* found_idx);
+LWRB_API uint8_t lwrb_find(const lwrb_t* buff, const void* bts, lwrb_sz_t len, lwrb_sz_t start_offset, lwrb_sz_t* found_idx);
+LWRB_API lwrb_sz_t lwrb_count_byte(const lwrb_t* buff, uint8_t delim);
 lwrb_sz_t lwrb_overwrite(lwrb_t* buff, const void* data, lwrb_sz_t btw);
 lwrb_sz_t lwrb_move(lwrb_t* dest, lwrb_t* src);
 
@@ -158,4 +745,9 @@ lwrb_sz_t lwrb_move(lwrb_t* dest, lwrb_t* src);
 }
 #endif /* __cplusplus */
 
+/* Header-only mode, core functions are built from the same source file in each compilation unit */
+#if defined(LWRB_HEADER_ONLY)
+#include "../../lwrb/lwrb.c"
+#endif /* defined(LWRB_HEADER_ONLY) */
+
 #endif /* LWRB_HDR_H */
@@ -0,0 +1,399 @@
+/**
+ * \file            lwrb.hpp
+ * \brief           LwRB - C++ wrappers with compile-time capacity
+ */
+
+/*
+ * Copyright (c) 2024 Tilen MAJERLE
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the "Software"), to deal in the Software without restriction,
+ * including without limitation the rights to use, copy, modify, merge,
+ * publish, distribute, sublicense, and/or sell copies of the Software,
+ * and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE
+ * AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * This file is part of LwRB - Lightweight ring buffer library.
+ *
+ * Author:          Tilen MAJERLE <tilen@majerle.eu>
+ * Version:         v3.3.0
+ */
+#ifndef LWRB_HDR_HPP
+#define LWRB_HDR_HPP
+
+#if __cplusplus < 201703L
+#error "lwrb.hpp requires C++17 or newer"
+#endif /* __cplusplus < 201703L */
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <new>
+#include <optional>
+#include <type_traits>
+#include <utility>
+#if __cplusplus >= 202002L
+#include <span>
+#endif /* __cplusplus >= 202002L */
+#include "lwrb/lwrb.h"
+
+/**
+ * \ingroup         LWRB
+ * \defgroup        LWRB_CPP C++ wrappers
+ * \brief           Header-only C++ wrappers with compile-time capacity
+ * \{
+ */
+
+namespace Lwrb {
+
+/**
+ * \brief           Byte ring buffer with statically allocated storage of `N` usable bytes.
+ *
+ * Thin RAII wrapper around \ref lwrb_t. All operations forward to the C library,
+ * \ref handle can be used for functions without a member counterpart.
+ *
+ * \tparam          N: Number of usable bytes. Must be power of `2` when `LWRB_POW2` is defined
+ */
+template <std::size_t N>
+class buffer {
+#if defined(LWRB_POW2)
+    static_assert(N > 0 && (N & (N - 1)) == 0, "LWRB_POW2 requires power of 2 buffer size");
+    static constexpr std::size_t storage_size = N;
+#else
+    static_assert(N > 0, "Buffer size must be greater than 0");
+    static constexpr std::size_t storage_size = N + 1; /* One byte is always kept free */
+#endif /* defined(LWRB_POW2) */
+
+  public:
+    buffer() noexcept { lwrb_init(&m_buff, m_data, static_cast<lwrb_sz_t>(storage_size)); }
+
+    ~buffer() { lwrb_free(&m_buff); }
+
+    buffer(const buffer&) = delete;
+    buffer& operator=(const buffer&) = delete;
+
+    /**
+     * \brief           Get number of usable bytes
+     */
+    static constexpr std::size_t
+    capacity() noexcept {
+        return N;
+    }
+
+    lwrb_sz_t
+    write(const void* data, lwrb_sz_t btw) noexcept {
+        return lwrb_write(&m_buff, data, btw);
+    }
+
+    lwrb_sz_t
+    read(void* data, lwrb_sz_t btr) noexcept {
+        return lwrb_read(&m_buff, data, btr);
+    }
+
+    lwrb_sz_t
+    peek(lwrb_sz_t skip_count, void* data, lwrb_sz_t btp) const noexcept {
+        return lwrb_peek(&m_buff, skip_count, data, btp);
+    }
+
+    lwrb_sz_t
+    skip(lwrb_sz_t len) noexcept {
+        return lwrb_skip(&m_buff, len);
+    }
+
+    lwrb_sz_t
+    advance(lwrb_sz_t len) noexcept {
+        return lwrb_advance(&m_buff, len);
+    }
+
+    lwrb_sz_t
+    size() const noexcept {
+        return lwrb_get_full(&m_buff);
+    }
+
+    lwrb_sz_t
+    free_size() const noexcept {
+        return lwrb_get_free(&m_buff);
+    }
+
+    void
+    reset() noexcept {
+        lwrb_reset(&m_buff);
+    }
+
+#if __cplusplus >= 202002L || __DOXYGEN__
+    /**
+     * \brief           Get readable data as two contiguous spans, second one is empty unless data wraps.
+     *
+     * Both spans are built from single pointer snapshot, concurrent write does not affect them.
+     * Call \ref skip to release the bytes after they have been processed
+     */
+    std::pair<std::span<const std::uint8_t>, std::span<const std::uint8_t>>
+    readable() noexcept {
+        lwrb_iovec_t spans[2];
+        lwrb_read_acquire(&m_buff, static_cast<lwrb_sz_t>(storage_size), spans);
+        return {std::span<const std::uint8_t>(static_cast<const std::uint8_t*>(spans[0].data), spans[0].len),
+                std::span<const std::uint8_t>(static_cast<const std::uint8_t*>(spans[1].data), spans[1].len)};
+    }
+#endif /* __cplusplus >= 202002L || __DOXYGEN__ */
+
+    /**
+     * \brief           Get underlying C buffer handle
+     */
+    lwrb_t*
+    handle() noexcept {
+        return &m_buff;
+    }
+
+    const lwrb_t*
+    handle() const noexcept {
+        return &m_buff;
+    }
+
+  private:
+    lwrb_t m_buff;
+    std::uint8_t m_data[storage_size];
+};
+
+/**
+ * \brief           Typed single-producer single-consumer ring of `N` elements of type `T`.
+ *
+ * Elements are constructed in place and moved out, instead of being copied byte by byte.
+ * Storage and indices live in the object, so index math folds to constants for given `N`.
+ *
+ * Indices run in range `0 .. 2 * N - 1`, which distinguishes full and empty ring
+ * without a spare element, for any `N`. When `N` is power of `2`, wrap is a mask.
+ *
+ * One thread may call producer functions (`push`, `emplace`) and another thread
+ * consumer functions (`pop`, `readable`, `consume`) concurrently.
+ *
+ * \tparam          T: Element type, must be nothrow destructible
+ * \tparam          N: Maximum number of elements
+ */
+template <typename T, std::size_t N>
+class ring {
+    static_assert(N > 0, "Ring capacity must be greater than 0");
+    static_assert(N <= SIZE_MAX / 2, "Ring capacity too large");
+    static_assert(std::is_nothrow_destructible<T>::value, "Element type must be nothrow destructible");
+
+  public:
+    using value_type = T;
+    using size_type = std::size_t;
+
+    ring() noexcept = default;
+
+    ~ring() { clear(); }
+
+    ring(const ring&) = delete;
+    ring& operator=(const ring&) = delete;
+
+    /**
+     * \brief           Get maximum number of elements
+     */
+    static constexpr size_type
+    capacity() noexcept {
+        return N;
+    }
+
+    /**
+     * \brief           Copy element to the ring
+     * \return          `true` on success, `false` if ring is full
+     */
+    bool
+    push(const T& value) {
+        return emplace(value);
+    }
+
+    /**
+     * \brief           Move element to the ring
+     * \return          `true` on success, `false` if ring is full
+     */
+    bool
+    push(T&& value) {
+        return emplace(std::move(value));
+    }
+
+    /**
+     * \brief           Construct element in place at the end of the ring
+     * \param[in]       args: Arguments forwarded to the constructor of `T`
+     * \return          `true` on success, `false` if ring is full
+     */
+    template <typename... Args>
+    bool
+    emplace(Args&&... args) {
+        size_type w = m_w.load(std::memory_order_relaxed);
+        size_type r = m_r.load(std::memory_order_acquire);
+
+        if (distance(r, w) == N) {
+            return false;
+        }
+        ::new (static_cast<void*>(&m_data[slot(w)])) T(std::forward<Args>(args)...);
+        m_w.store(next(w, 1), std::memory_order_release);
+        return true;
+    }
+
+    /**
+     * \brief           Move oldest element out of the ring
+     * \param[out]      value: Variable to move element to
+     * \return          `true` on success, `false` if ring is empty
+     */
+    bool
+    pop(T& value) {
+        size_type r = m_r.load(std::memory_order_relaxed);
+        size_type w = m_w.load(std::memory_order_acquire);
+
+        if (r == w) {
+            return false;
+        }
+        T* elem = at(r);
+        value = std::move(*elem);
+        elem->~T();
+        m_r.store(next(r, 1), std::memory_order_release);
+        return true;
+    }
+
+    /**
+     * \brief           Move oldest element out of the ring
+     * \return          Element or `std::nullopt` if ring is empty
+     */
+    std::optional<T>
+    pop() {
+        size_type r = m_r.load(std::memory_order_relaxed);
+        size_type w = m_w.load(std::memory_order_acquire);
+
+        if (r == w) {
+            return std::nullopt;
+        }
+        T* elem = at(r);
+        std::optional<T> value(std::move(*elem));
+        elem->~T();
+        m_r.store(next(r, 1), std::memory_order_release);
+        return value;
+    }
+
+#if __cplusplus >= 202002L || __DOXYGEN__
+    /**
+     * \brief           Get readable elements as two contiguous spans, second one is empty unless data wraps.
+     *
+     * Elements stay in the ring until released with \ref consume. Consumer side only
+     */
+    std::pair<std::span<T>, std::span<T>>
+    readable() noexcept {
+        size_type r = m_r.load(std::memory_order_relaxed);
+        size_type w = m_w.load(std::memory_order_acquire);
+        size_type len = distance(r, w), idx = slot(r);
+        size_type len0 = len < N - idx ? len : N - idx;
+
+        return {std::span<T>(at(r), len0), std::span<T>(len0 < len ? at(0) : at(r), len - len0)};
+    }
+#endif /* __cplusplus >= 202002L || __DOXYGEN__ */
+
+    /**
+     * \brief           Destroy and release oldest elements. Consumer side only
+     * \param[in]       count: Maximum number of elements to release
+     * \return          Number of released elements
+     */
+    size_type
+    consume(size_type count) noexcept {
+        size_type r = m_r.load(std::memory_order_relaxed);
+        size_type w = m_w.load(std::memory_order_acquire);
+        size_type len = distance(r, w);
+
+        count = count < len ? count : len;
+        if (!std::is_trivially_destructible<T>::value) {
+            for (size_type i = 0; i < count; ++i) {
+                at(next(r, i))->~T();
+            }
+        }
+        m_r.store(next(r, count), std::memory_order_release);
+        return count;
+    }
+
+    /**
+     * \brief           Destroy all elements. Consumer side only
+     */
+    void
+    clear() noexcept {
+        consume(N);
+    }
+
+    /**
+     * \brief           Get number of elements in the ring
+     */
+    size_type
+    size() const noexcept {
+        size_type r = m_r.load(std::memory_order_acquire);
+        size_type w = m_w.load(std::memory_order_acquire);
+        return distance(r, w);
+    }
+
+    bool
+    empty() const noexcept {
+        return size() == 0;
+    }
+
+    bool
+    full() const noexcept {
+        return size() == N;
+    }
+
+  private:
+    struct alignas(T) storage_t {
+        unsigned char bytes[sizeof(T)];
+    };
+
+    /* Position of index in element storage */
+    static constexpr size_type
+    slot(size_type idx) noexcept {
+        return idx < N ? idx : idx - N;
+    }
+
+    /* Advance index by `count <= N` positions */
+    static constexpr size_type
+    next(size_type idx, size_type count) noexcept {
+        return idx + count < 2 * N ? idx + count : idx + count - 2 * N;
+    }
+
+    /* Number of elements between read and write index */
+    static constexpr size_type
+    distance(size_type r, size_type w) noexcept {
+        size_type len = w >= r ? w - r : w + 2 * N - r;
+        /* Indices loaded at different times by a third thread may overshoot */
+        return len < N ? len : N;
+    }
+
+    T*
+    at(size_type idx) noexcept {
+        return std::launder(reinterpret_cast<T*>(&m_data[slot(idx)]));
+    }
+
+#if defined(LWRB_CACHELINE_ISOLATE)
+    LWRB_CACHELINE_ALIGN std::atomic<size_type> m_w{0}; /*!< Producer owned write index */
+    LWRB_CACHELINE_ALIGN std::atomic<size_type> m_r{0}; /*!< Consumer owned read index */
+    LWRB_CACHELINE_ALIGN storage_t m_data[N];
+#else
+    std::atomic<size_type> m_w{0}; /*!< Producer owned write index */
+    std::atomic<size_type> m_r{0}; /*!< Consumer owned read index */
+    storage_t m_data[N];
+#endif /* defined(LWRB_CACHELINE_ISOLATE) */
+};
+
+} /* namespace Lwrb */
+
+/**
+ * \}
+ */
+
+#endif /* LWRB_HDR_HPP */
@@ -31,60 +31,702 @@
  * Author:          Tilen MAJERLE <tilen@majerle.eu>
  * Version:         v3.3.0
  */
+#ifndef LWRB_SRC_C
+#define LWRB_SRC_C /* Header-only mode includes this file from lwrb.h */
+
+#if defined(LWRB_WAIT) && !defined(_GNU_SOURCE)
+#define _GNU_SOURCE /* syscall, clock_gettime */
+#endif
 #include "lwrb/lwrb.h"
+#include "lwrb_priv.h"
 
 /* Memory set and copy functions */
-#define BUF_MEMSET      memset
-#define BUF_MEMCPY      memcpy
+#define BUF_MEMSET memset
+#define BUF_MEMCPY memcpy
 
-#define BUF_IS_VALID(b) ((b) != NULL && (b)->buff != NULL && (b)->size > 0)
-#define BUF_MIN(x, y)   ((x) < (y) ? (x) : (y))
-#define BUF_MAX(x, y)   ((x) > (y) ? (x) : (y))
-#define BUF_SEND_EVT(b, type, bp)                                                                                      \
+/*
+ * Notify waiting threads and event callback after operation.
+ *
+ * `full` is fill level right after the operation, as calculated by the caller from its local pointers.
+ * It is only evaluated for watermark events, hence it costs nothing when they are not used.
+ */
+#if defined(LWRB_EVT_WATERMARK)
+#define BUF_NOTIFY_EVT(b, type, bp, full)                                                                              \
+    do {                                                                                                               \
+        BUF_WAKE((b), (type));                                                                                         \
+        BUF_RESIZE_PEAK((b), (type));                                                                                  \
+        if ((b)->evt_fn != NULL) {                                                                                     \
+            if ((b)->evt_high == 0) {                                                                                  \
+                (b)->evt_fn((void*)(b), (type), (bp));                                                                 \
+            } else {                                                                                                   \
+                prv_send_watermark_evt((b), (type), (bp), (full));                                                     \
+            }                                                                                                          \
+        }                                                                                                              \
+    } while (0)
+#else
+#define BUF_NOTIFY_EVT(b, type, bp, full)                                                                              \
     do {                                                                                                               \
+        BUF_WAKE((b), (type));                                                                                         \
+        BUF_RESIZE_PEAK((b), (type));                                                                                  \
         if ((b)->evt_fn != NULL) {                                                                                     \
             (b)->evt_fn((void*)(b), (type), (bp));                                                                     \
         }                                                                                                              \
     } while (0)
+#endif /* defined(LWRB_EVT_WATERMARK) */
+#define BUF_SEND_EVT(b, type, bp, full)                                                                                \
+    do {                                                                                                               \
+        BUF_STATS((b), (type), (bp));                                                                                  \
+        BUF_NOTIFY_EVT((b), (type), (bp), (full));                                                                     \
+    } while (0)
 
+/* Fill level after write of `bp` bytes, from free memory calculated before the write */
+#define BUF_FULL_AFTER_WRITE(b, free, bp) (prv_calc_free((b), 0, 0) - (free) + (bp))
+
+#if defined(LWRB_MULTI_PRODUCER) || defined(LWRB_MULTI_CONSUMER)
 /*
- * Optional atomic operations.
+ * Called while producer (consumer) waits for previous producers (consumers) to publish (release) their data.
+ * Thread is yielded on POSIX systems, as previous producer may be preempted
+ * on the same core. Application may define its own implementation.
+ */
+#ifndef LWRB_CPU_RELAX
+#if defined(__unix__) || defined(__APPLE__)
+#include <sched.h>
+#define LWRB_CPU_RELAX() sched_yield()
+#elif defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#define LWRB_CPU_RELAX() __builtin_ia32_pause()
+#else
+#define LWRB_CPU_RELAX()
+#endif
+#endif /* LWRB_CPU_RELAX */
+#endif /* defined(LWRB_MULTI_PRODUCER) || defined(LWRB_MULTI_CONSUMER) */
+
+#if defined(LWRB_WAIT)
+#include <errno.h>
+#include <limits.h>
+#include <linux/futex.h>
+#include <sched.h>
+#include <sys/syscall.h>
+#include <time.h>
+#include <unistd.h>
+
+#if !defined(CLOCK_MONOTONIC)
+#error "LWRB_WAIT requires _GNU_SOURCE. Define it globally, or include lwrb.h before any system header"
+#endif /* !defined(CLOCK_MONOTONIC) */
+
+/* Number of busy checks before waiting thread starts yielding */
+#ifndef LWRB_WAIT_SPIN_COUNT
+#define LWRB_WAIT_SPIN_COUNT 128
+#endif /* LWRB_WAIT_SPIN_COUNT */
+
+/* Number of yielded checks before waiting thread parks on futex */
+#ifndef LWRB_WAIT_YIELD_COUNT
+#define LWRB_WAIT_YIELD_COUNT 16
+#endif /* LWRB_WAIT_YIELD_COUNT */
+
+/**
+ * \brief           Wake all threads parked on the futex word, if there are any.
+ *
+ * Fast path is a single relaxed load of waiters counter, system call is made only
+ * when at least one thread is parked.
+ * Full fence orders preceding pointer publish against waiters load,
+ * matched with the fence in \ref prv_wait after waiter registration
+ *
+ * \param[in]       seq: Futex word to increment and wake threads on
+ * \param[in]       waiters: Number of threads parked on `seq`
+ */
+static inline void
+prv_wake(lwrb_atomic_uint_t* seq, lwrb_atomic_uint_t* waiters) {
+    atomic_thread_fence(memory_order_seq_cst);
+    if (atomic_load_explicit(waiters, memory_order_relaxed) > 0) {
+        atomic_fetch_add_explicit(seq, 1, memory_order_release);
+        syscall(SYS_futex, seq, FUTEX_WAKE, INT_MAX, NULL, NULL, 0);
+    }
+}
+
+/* Wake waiting readers after write and waiting writers after read */
+#define BUF_WAKE(b, type)                                                                                              \
+    do {                                                                                                               \
+        if ((type) != LWRB_EVT_READ) {                                                                                 \
+            prv_wake(&(b)->w_seq, &(b)->r_wait);                                                                       \
+        }                                                                                                              \
+        if ((type) != LWRB_EVT_WRITE) {                                                                                \
+            prv_wake(&(b)->r_seq, &(b)->w_wait);                                                                       \
+        }                                                                                                              \
+    } while (0)
+#else
+#define BUF_WAKE(b, type)
+#endif /* defined(LWRB_WAIT) */
+
+#if defined(LWRB_EVT_WATERMARK)
+/**
+ * \brief           Send watermark event, when operation made buffer fill level cross the watermark.
+ *
+ * Fill level is the one seen by the operation itself, calculated from its local pointers.
+ * Data processed by the other side in the meantime may hide a crossing,
+ * in which case the other side has already handled the data.
  *
- * Disabling this does not just make individual reads/writes non-atomic,
- * it removes any ordering/visibility guarantee between the write and read
- * side entirely. Nothing in this file synchronizes threads or interrupts
- * anymore at that point - it becomes fully the application's job to add
- * whatever barriers, volatile access or locking the target platform needs.
+ * \param[in]       buff: Ring buffer instance
+ * \param[in]       type: Operation event type
+ * \param[in]       bp: Number of bytes written or read
+ * \param[in]       full: Fill level after the operation
+ */
+static inline void
+prv_send_watermark_evt(lwrb_t* buff, lwrb_evt_type_t type, lwrb_sz_t bp, lwrb_sz_t full) {
+    if (type == LWRB_EVT_WRITE) {
+        if (full >= buff->evt_high && full - BUF_MIN(full, bp) < buff->evt_high) {
+            buff->evt_fn(buff, LWRB_EVT_HIGH_WATERMARK, full);
+        }
+    } else if (type == LWRB_EVT_READ) {
+        if (full <= buff->evt_low && full + bp > buff->evt_low) {
+            buff->evt_fn(buff, LWRB_EVT_LOW_WATERMARK, full);
+        }
+    } else {
+        buff->evt_fn(buff, type, bp);
+    }
+}
+#endif /* defined(LWRB_EVT_WATERMARK) */
+
+#if defined(LWRB_STATS)
+/*
+ * Side with single writer updates its counters with plain load and store.
+ * Read-modify-write is needed only when several producers (consumers) share the side
  */
+#if defined(LWRB_MULTI_PRODUCER)
+#define BUF_STATS_W_MULTI 1
+#else
+#define BUF_STATS_W_MULTI 0
+#endif /* defined(LWRB_MULTI_PRODUCER) */
+#if defined(LWRB_MULTI_CONSUMER)
+#define BUF_STATS_R_MULTI 1
+#else
+#define BUF_STATS_R_MULTI 0
+#endif /* defined(LWRB_MULTI_CONSUMER) */
+
 #ifdef LWRB_DISABLE_ATOMIC
-#define LWRB_INIT(var, val)        (var) = (val)
-#define LWRB_LOAD(var, type)       (var)
-#define LWRB_STORE(var, val, type) (var) = (val)
+#define BUF_STATS_ADD(multi, var, val) ((void)(multi), (var) += (val))
+#define BUF_STATS_FENCE(type)
+#else
+#define BUF_STATS_ADD(multi, var, val)                                                                                 \
+    do {                                                                                                               \
+        if (multi) {                                                                                                   \
+            atomic_fetch_add_explicit(&(var), (val), memory_order_relaxed);                                            \
+        } else {                                                                                                       \
+            LWRB_STORE((var), LWRB_LOAD((var), memory_order_relaxed) + (val), memory_order_relaxed);                   \
+        }                                                                                                              \
+    } while (0)
+#define BUF_STATS_FENCE(type) atomic_thread_fence(type)
+#endif /* LWRB_DISABLE_ATOMIC */
+
+/*
+ * Statistics of each side are updated between `seq_begin` and `seq_end` increments,
+ * so that snapshot can detect concurrent update and retry
+ */
+#define BUF_STATS_BEGIN(multi, st)                                                                                     \
+    do {                                                                                                               \
+        BUF_STATS_ADD((multi), (st)->seq_begin, 1);                                                                    \
+        BUF_STATS_FENCE(memory_order_release);                                                                         \
+    } while (0)
+#define BUF_STATS_END(multi, st)                                                                                       \
+    do {                                                                                                               \
+        BUF_STATS_FENCE(memory_order_release);                                                                         \
+        BUF_STATS_ADD((multi), (st)->seq_end, 1);                                                                      \
+    } while (0)
+
+/**
+ * \brief           Count short or failed operation.
+ *                  Called when operation calculates number of bytes it can process
+ * \param[in]       st: Statistics of operation side
+ * \param[in]       req: Number of bytes requested by the application
+ * \param[in]       avail: Number of bytes operation is going to process
+ * \param[in]       multi: Set to `1` when several threads update the side
+ */
+static void
+prv_stats_req(lwrb_stats_side_t* st, lwrb_sz_t req, lwrb_sz_t avail, uint8_t multi) {
+    if (avail >= req) {
+        return;
+    }
+    BUF_STATS_BEGIN(multi, st);
+    if (avail == 0) {
+        BUF_STATS_ADD(multi, st->failed_ops, 1);
+    } else {
+        BUF_STATS_ADD(multi, st->short_ops, 1);
+    }
+    BUF_STATS_END(multi, st);
+}
+
+/**
+ * \brief           Count processed bytes, peak fill level and full or empty transitions.
+ *                  Called after operation published new pointer
+ * \param[in]       buff: Ring buffer instance
+ * \param[in]       type: Operation event type
+ * \param[in]       bp: Number of bytes written or read
+ */
+static void
+prv_stats_done(lwrb_t* buff, lwrb_evt_type_t type, lwrb_sz_t bp) {
+    lwrb_sz_t full;
+
+    if (type == LWRB_EVT_WRITE) {
+        BUF_STATS_BEGIN(BUF_STATS_W_MULTI, &buff->w_stats);
+        BUF_STATS_ADD(BUF_STATS_W_MULTI, buff->w_stats.bytes, bp);
+        if (bp > 0) {
+            full = lwrb_get_full(buff);
+#if defined(LWRB_MULTI_PRODUCER)
+            lwrb_sz_t peak = LWRB_LOAD(buff->w_stats.peak, memory_order_relaxed);
+            while (full > peak
+                   && !atomic_compare_exchange_weak_explicit(&buff->w_stats.peak, &peak, full, memory_order_relaxed,
+                                                             memory_order_relaxed)) {}
+#else
+            if (full > LWRB_LOAD(buff->w_stats.peak, memory_order_relaxed)) {
+                LWRB_STORE(buff->w_stats.peak, full, memory_order_relaxed);
+            }
+#endif /* defined(LWRB_MULTI_PRODUCER) */
+            if (lwrb_get_free(buff) == 0) {
+                BUF_STATS_ADD(BUF_STATS_W_MULTI, buff->w_stats.edges, 1);
+            }
+        }
+        BUF_STATS_END(BUF_STATS_W_MULTI, &buff->w_stats);
+    } else if (type == LWRB_EVT_READ) {
+        BUF_STATS_BEGIN(BUF_STATS_R_MULTI, &buff->r_stats);
+        BUF_STATS_ADD(BUF_STATS_R_MULTI, buff->r_stats.bytes, bp);
+        if (bp > 0 && lwrb_get_full(buff) == 0) {
+            BUF_STATS_ADD(BUF_STATS_R_MULTI, buff->r_stats.edges, 1);
+        }
+        BUF_STATS_END(BUF_STATS_R_MULTI, &buff->r_stats);
+    }
+}
+
+/**
+ * \brief           Initialize statistics counters of one side to `0`
+ * \param[in]       st: Statistics of one side
+ */
+static void
+prv_stats_init(lwrb_stats_side_t* st) {
+    LWRB_INIT(st->seq_begin, 0);
+    LWRB_INIT(st->seq_end, 0);
+    LWRB_INIT(st->bytes, 0);
+    LWRB_INIT(st->short_ops, 0);
+    LWRB_INIT(st->failed_ops, 0);
+    LWRB_INIT(st->edges, 0);
+    LWRB_INIT(st->peak, 0);
+    LWRB_INIT(st->dropped, 0);
+}
+
+#define BUF_STATS(b, type, bp)         prv_stats_done((b), (type), (bp))
+#define BUF_STATS_W_REQ(b, req, avail) prv_stats_req(&(b)->w_stats, (req), (avail), BUF_STATS_W_MULTI)
+#define BUF_STATS_R_REQ(b, req, avail) prv_stats_req(&(b)->r_stats, (req), (avail), BUF_STATS_R_MULTI)
+#else
+#define BUF_STATS(b, type, bp)
+#define BUF_STATS_W_REQ(b, req, avail)
+#define BUF_STATS_R_REQ(b, req, avail)
+#endif /* defined(LWRB_STATS) */
+
+#if defined(LWRB_RESIZE)
+#include <stdlib.h>
+
+/* Allocation hooks for resize functions. Application may define its own implementation */
+#ifndef LWRB_RESIZE_ALLOC
+#define LWRB_RESIZE_ALLOC(size) malloc(size)
+#endif
+#ifndef LWRB_RESIZE_FREE
+#define LWRB_RESIZE_FREE(ptr) free(ptr)
+#endif
+
+/* Track peak buffer occupancy for adaptive resize, on write events only */
+#define BUF_RESIZE_PEAK(b, type)                                                                                       \
+    do {                                                                                                               \
+        if ((type) == LWRB_EVT_WRITE) {                                                                                \
+            lwrb_sz_t full = lwrb_get_full(b);                                                                         \
+            (b)->peak = BUF_MAX((b)->peak, full);                                                                      \
+        }                                                                                                              \
+    } while (0)
+#else
+#define BUF_RESIZE_PEAK(b, type)
+#endif /* defined(LWRB_RESIZE) */
+
+#if defined(LWRB_NT_COPY)
+/*
+ * Non-temporal copy helpers. Stores bypass the cache on x86 with SSE2,
+ * loads prefetch source with non-temporal hint where compiler supports it.
+ * Other platforms fall back to plain memory copy.
+ */
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define BUF_NT_STORE         1
+#define BUF_NT_FENCE()       _mm_sfence()
+#define BUF_NT_PREFETCH(ptr) _mm_prefetch((const char*)(ptr), _MM_HINT_NTA)
+#elif defined(__GNUC__)
+#define BUF_NT_STORE         0
+#define BUF_NT_FENCE()
+#define BUF_NT_PREFETCH(ptr) __builtin_prefetch((ptr), 0, 0)
 #else
-#define LWRB_INIT(var, val)        atomic_init(&(var), (val))
-#define LWRB_LOAD(var, type)       atomic_load_explicit(&(var), (type))
-#define LWRB_STORE(var, val, type) atomic_store_explicit(&(var), (val), (type))
+#define BUF_NT_STORE 0
+#define BUF_NT_FENCE()
+#define BUF_NT_PREFETCH(ptr)
 #endif
 
+/* Distance in units of bytes, at which source is prefetched ahead of non-temporal load copy */
+#ifndef LWRB_NT_PREFETCH_DISTANCE
+#define LWRB_NT_PREFETCH_DISTANCE 512
+#endif /* LWRB_NT_PREFETCH_DISTANCE */
+
+/**
+ * \brief           Copy memory with non-temporal stores to destination.
+ *                  Caller must execute `BUF_NT_FENCE` before data is published
+ * \param[out]      dst: Destination memory
+ * \param[in]       src: Source memory
+ * \param[in]       len: Number of bytes to copy
+ */
+static void
+prv_memcpy_nt_store(uint8_t* dst, const uint8_t* src, lwrb_sz_t len) {
+#if BUF_NT_STORE
+    lwrb_sz_t head = BUF_MIN((lwrb_sz_t)(-(uintptr_t)dst & 0x0F), len);
+
+    /* Streaming stores need 16-byte aligned destination */
+    BUF_MEMCPY(dst, src, head);
+    dst += head;
+    src += head;
+    len -= head;
+    for (; len >= 64; len -= 64, dst += 64, src += 64) {
+        __m128i a = _mm_loadu_si128((const __m128i*)(const void*)src);
+        __m128i b = _mm_loadu_si128((const __m128i*)(const void*)(src + 16));
+        __m128i c = _mm_loadu_si128((const __m128i*)(const void*)(src + 32));
+        __m128i d = _mm_loadu_si128((const __m128i*)(const void*)(src + 48));
+        _mm_stream_si128((__m128i*)(void*)dst, a);
+        _mm_stream_si128((__m128i*)(void*)(dst + 16), b);
+        _mm_stream_si128((__m128i*)(void*)(dst + 32), c);
+        _mm_stream_si128((__m128i*)(void*)(dst + 48), d);
+    }
+#endif /* BUF_NT_STORE */
+    BUF_MEMCPY(dst, src, len);
+}
+
+/**
+ * \brief           Copy memory, prefetching source with non-temporal hint
+ * \param[out]      dst: Destination memory
+ * \param[in]       src: Source memory
+ * \param[in]       len: Number of bytes to copy
+ */
+static void
+prv_memcpy_nt_load(uint8_t* dst, const uint8_t* src, lwrb_sz_t len) {
+    for (; len >= 256; len -= 256, dst += 256, src += 256) {
+        BUF_NT_PREFETCH(src + LWRB_NT_PREFETCH_DISTANCE);
+        BUF_NT_PREFETCH(src + LWRB_NT_PREFETCH_DISTANCE + 64);
+        BUF_NT_PREFETCH(src + LWRB_NT_PREFETCH_DISTANCE + 128);
+        BUF_NT_PREFETCH(src + LWRB_NT_PREFETCH_DISTANCE + 192);
+        BUF_MEMCPY(dst, src, 256);
+    }
+    BUF_MEMCPY(dst, src, len);
+}
+#endif /* defined(LWRB_NT_COPY) */
+
+/* Keep reservation pointers in sync when single-producer (single-consumer) functions modify write (read) pointer */
+#if defined(LWRB_MULTI_PRODUCER)
+#define BUF_SYNC_W_RSV(b, val) LWRB_STORE((b)->w_rsv, (val), memory_order_relaxed)
+#else
+#define BUF_SYNC_W_RSV(b, val)
+#endif /* defined(LWRB_MULTI_PRODUCER) */
+#if defined(LWRB_MULTI_CONSUMER)
+#define BUF_SYNC_R_RSV(b, val) LWRB_STORE((b)->r_rsv, (val), memory_order_relaxed)
+#else
+#define BUF_SYNC_R_RSV(b, val)
+#endif /* defined(LWRB_MULTI_CONSUMER) */
+
+/*
+ * Pointer arithmetic.
+ *
+ * By default, read and write pointers are always kept in range `0 .. size - 1`,
+ * they wrap at the end of the buffer and one byte is always kept free
+ * to distinguish between full and empty buffer.
+ *
+ * With `LWRB_POW2` defined, buffer size must be power of `2`. Pointers then count up freely
+ * and get masked with `size - 1` only when accessing memory. Number of bytes in the buffer
+ * is always `w - r` (unsigned arithmetic handles pointer wrap), so complete buffer size is usable.
+ */
+#if defined(LWRB_POW2)
+#define BUF_IDX(b, ptr)          ((ptr) & ((b)->size - 1))
+#define BUF_PTR_ADD(b, ptr, len) ((ptr) + (len))
+#else
+#define BUF_IDX(b, ptr)          (ptr)
+#define BUF_PTR_ADD(b, ptr, len) prv_ptr_add((b), (ptr), (len))
+
+/**
+ * \brief           Advance pointer for `len` bytes, with wrap-around at the end of buffer
+ * \param[in]       buff: Ring buffer instance
+ * \param[in]       ptr: Read or write pointer value, in range `0 .. size - 1`
+ * \param[in]       len: Number of bytes to advance, must not be greater than `size`
+ * \return          New pointer value
+ */
+static inline lwrb_sz_t
+prv_ptr_add(const lwrb_t* buff, lwrb_sz_t ptr, lwrb_sz_t len) {
+    ptr += len;
+    if (ptr >= buff->size) {
+        ptr -= buff->size;
+    }
+    return ptr;
+}
+#endif /* defined(LWRB_POW2) */
+
+/*
+ * End of linearly accessible memory, counted from the beginning of the buffer data.
+ *
+ * For mirrored buffer, memory is mapped twice, back to back, hence any
+ * read or write up to buffer size is always one linear block.
+ */
+#if defined(LWRB_MIRROR)
+#define BUF_LIN_END(b) ((b)->linear_size)
+#else
+#define BUF_LIN_END(b) ((b)->size)
+#endif /* defined(LWRB_MIRROR) */
+
+/**
+ * \brief           Calculate number of free bytes from local copies of write and read pointers
+ * \param[in]       buff: Ring buffer instance
+ * \param[in]       w_ptr: Write pointer value
+ * \param[in]       r_ptr: Read pointer value
+ * \return          Number of free bytes in memory
+ */
+static inline lwrb_sz_t
+prv_calc_free(const lwrb_t* buff, lwrb_sz_t w_ptr, lwrb_sz_t r_ptr) {
+#if defined(LWRB_POW2)
+    return buff->size - (w_ptr - r_ptr);
+#else
+    lwrb_sz_t size;
+
+    if (w_ptr >= r_ptr) {
+        size = buff->size - (w_ptr - r_ptr);
+    } else {
+        size = r_ptr - w_ptr;
+    }
+
+    /* Buffer free size is always 1 less than actual size */
+    return size - 1;
+#endif /* defined(LWRB_POW2) */
+}
+
+/**
+ * \brief           Calculate number of used bytes from local copies of write and read pointers
+ * \param[in]       buff: Ring buffer instance
+ * \param[in]       w_ptr: Write pointer value
+ * \param[in]       r_ptr: Read pointer value
+ * \return          Number of bytes ready to be read
+ */
+static inline lwrb_sz_t
+prv_calc_full(const lwrb_t* buff, lwrb_sz_t w_ptr, lwrb_sz_t r_ptr) {
+#if defined(LWRB_POW2)
+    (void)buff;
+    return w_ptr - r_ptr;
+#else
+    if (w_ptr >= r_ptr) {
+        return w_ptr - r_ptr;
+    }
+    return buff->size - (r_ptr - w_ptr);
+#endif /* defined(LWRB_POW2) */
+}
+
+/**
+ * \brief           Copy data to buffer memory, starting at write pointer position.
+ *                  Copies linear part first, then overflow part to the beginning of the buffer
+ * \param[in]       buff: Ring buffer instance
+ * \param[in]       w_ptr: Write pointer value to start copy at
+ * \param[in]       data: Data to copy
+ * \param[in]       len: Number of bytes to copy, must not be greater than free memory
+ */
+static inline void
+prv_copy_to_buff(lwrb_t* buff, lwrb_sz_t w_ptr, const uint8_t* data, lwrb_sz_t len) {
+    lwrb_sz_t w_idx = BUF_IDX(buff, w_ptr), tocopy;
+
+    tocopy = BUF_MIN(BUF_LIN_END(buff) - w_idx, len);
+#if defined(LWRB_NT_COPY)
+    if (buff->nt_w_threshold > 0 && len >= buff->nt_w_threshold) {
+        prv_memcpy_nt_store(&buff->buff[w_idx], data, tocopy);
+        if (len > tocopy) {
+            prv_memcpy_nt_store(buff->buff, &data[tocopy], len - tocopy);
+        }
+        BUF_NT_FENCE(); /* Streaming stores are weakly ordered, complete them before write pointer is published */
+        return;
+    }
+#endif /* defined(LWRB_NT_COPY) */
+    BUF_MEMCPY(&buff->buff[w_idx], data, tocopy);
+    if (len > tocopy) {
+        BUF_MEMCPY(buff->buff, &data[tocopy], len - tocopy);
+    }
+}
+
+/**
+ * \brief           Copy data from buffer memory, starting at read pointer position.
+ *                  Copies linear part first, then overflow part from the beginning of the buffer
+ * \param[in]       buff: Ring buffer instance
+ * \param[in]       r_ptr: Read pointer value to start copy at
+ * \param[out]      data: Output memory to copy data to
+ * \param[in]       len: Number of bytes to copy, must not be greater than full memory
+ */
+static inline void
+prv_copy_from_buff(const lwrb_t* buff, lwrb_sz_t r_ptr, uint8_t* data, lwrb_sz_t len) {
+    lwrb_sz_t r_idx = BUF_IDX(buff, r_ptr), tocopy;
+
+    tocopy = BUF_MIN(BUF_LIN_END(buff) - r_idx, len);
+#if defined(LWRB_NT_COPY)
+    if (buff->nt_r_threshold > 0 && len >= buff->nt_r_threshold) {
+        prv_memcpy_nt_load(data, &buff->buff[r_idx], tocopy);
+        if (len > tocopy) {
+            prv_memcpy_nt_load(&data[tocopy], buff->buff, len - tocopy);
+        }
+        return;
+    }
+#endif /* defined(LWRB_NT_COPY) */
+    BUF_MEMCPY(data, &buff->buff[r_idx], tocopy);
+    if (len > tocopy) {
+        BUF_MEMCPY(&data[tocopy], buff->buff, len - tocopy);
+    }
+}
+
+/**
+ * \brief           Describe `len` bytes of buffer memory, starting at pointer position,
+ *                  as linear part and overflow part
+ * \param[in]       buff: Ring buffer instance
+ * \param[in]       ptr: Read or write pointer value
+ * \param[in]       len: Number of bytes, must not be greater than buffer size
+ * \param[out]      spans: Array of `2` entries to fill.
+ *                      Unused entry has data set to `NULL` and length set to `0`
+ * \return          Value of `len` parameter
+ */
+static lwrb_sz_t
+prv_get_spans(const lwrb_t* buff, lwrb_sz_t ptr, lwrb_sz_t len, lwrb_iovec_t* spans) {
+    lwrb_sz_t idx = BUF_IDX(buff, ptr), first;
+
+    first = BUF_MIN(BUF_LIN_END(buff) - idx, len);
+    spans[0].data = first > 0 ? &buff->buff[idx] : NULL;
+    spans[0].len = first;
+    spans[1].data = len > first ? buff->buff : NULL;
+    spans[1].len = len - first;
+    return len;
+}
+
+#if defined(LWRB_CACHELINE_ISOLATE)
+
+/**
+ * \brief           Get free memory for write operation, using producer's copy of read pointer
+ *
+ * Read pointer is only loaded from the consumer's cache line when the local copy
+ * does not show enough free memory to satisfy `req` bytes. Local copy can only lag behind,
+ * hence free memory calculated from it is never more than actual free memory.
+ *
+ * \note            Must only be called from the write (producer) context
+ * \param[in]       buff: Ring buffer instance
+ * \param[in]       req: Number of bytes the caller would like to write
+ * \return          Number of free bytes in memory
+ */
+static lwrb_sz_t
+prv_get_free_cached(lwrb_t* buff, lwrb_sz_t req) {
+    lwrb_sz_t free, w_ptr;
+
+    w_ptr = LWRB_LOAD(buff->w_ptr, memory_order_relaxed);
+    free = prv_calc_free(buff, w_ptr, buff->r_ptr_cache);
+    if (free < req) {
+        buff->r_ptr_cache = LWRB_LOAD(buff->r_ptr, memory_order_acquire);
+        free = prv_calc_free(buff, w_ptr, buff->r_ptr_cache);
+    }
+    return free;
+}
+
+/**
+ * \brief           Get full memory for read operation, using consumer's copy of write pointer
+ *
+ * Write pointer is only loaded from the producer's cache line when the local copy
+ * does not show enough data to satisfy `req` bytes.
+ *
+ * \note            Must only be called from the read (consumer) context
+ * \param[in]       buff: Ring buffer instance
+ * \param[in]       req: Number of bytes the caller would like to read
+ * \return          Number of bytes ready to be read
+ */
+static lwrb_sz_t
+prv_get_full_cached(lwrb_t* buff, lwrb_sz_t req) {
+    lwrb_sz_t full, r_ptr;
+
+    r_ptr = LWRB_LOAD(buff->r_ptr, memory_order_relaxed);
+    full = prv_calc_full(buff, buff->w_ptr_cache, r_ptr);
+    if (full < req) {
+        buff->w_ptr_cache = LWRB_LOAD(buff->w_ptr, memory_order_acquire);
+        full = prv_calc_full(buff, buff->w_ptr_cache, r_ptr);
+    }
+    return full;
+}
+
+#define BUF_GET_FREE(b, req) prv_get_free_cached((b), (req))
+#define BUF_GET_FULL(b, req) prv_get_full_cached((b), (req))
+#else
+#define BUF_GET_FREE(b, req) lwrb_get_free(b)
+#define BUF_GET_FULL(b, req) lwrb_get_full(b)
+#endif /* defined(LWRB_CACHELINE_ISOLATE) */
+
 /**
  * \brief           Initialize buffer handle to default values with size and buffer data array
  * \param[in]       buff: Ring buffer instance
  * \param[in]       buffdata: Pointer to memory to use as buffer data
  * \param[in]       size: Size of `buffdata` in units of bytes
- *                      Maximum number of bytes buffer can hold is `size - 1`
+ *                      Maximum number of bytes buffer can hold is `size - 1`.
+ *                      When `LWRB_POW2` is defined, size must be power of `2`
+ *                      and buffer can hold full `size` bytes
  * \return          `1` on success, `0` otherwise
  */
-uint8_t
+LWRB_API uint8_t
 lwrb_init(lwrb_t* buff, void* buffdata, lwrb_sz_t size) {
     if (buff == NULL || buffdata == NULL || size == 0) {
         return 0;
     }
+#if defined(LWRB_POW2)
+    if ((size & (size - 1)) != 0) {
+        return 0;
+    }
+#endif /* defined(LWRB_POW2) */
 
     buff->evt_fn = NULL;
+#if defined(LWRB_EVT_WATERMARK)
+    buff->evt_low = 0;
+    buff->evt_high = 0;
+#endif /* defined(LWRB_EVT_WATERMARK) */
     buff->size = size;
+#if defined(LWRB_MIRROR)
+    buff->linear_size = size;
+#endif /* defined(LWRB_MIRROR) */
+#if defined(LWRB_ELEM)
+    buff->elem_size = 1;
+#endif /* defined(LWRB_ELEM) */
+#if defined(LWRB_RESIZE)
+    buff->peak = 0;
+    buff->mem_alloc = 0;
+#endif /* defined(LWRB_RESIZE) */
+#if defined(LWRB_NT_COPY)
+    buff->nt_w_threshold = 0;
+    buff->nt_r_threshold = 0;
+#endif /* defined(LWRB_NT_COPY) */
     buff->buff = buffdata;
     LWRB_INIT(buff->w_ptr, 0);
     LWRB_INIT(buff->r_ptr, 0);
+#if defined(LWRB_LOSSY)
+    LWRB_INIT(buff->w_head, 0);
+#endif /* defined(LWRB_LOSSY) */
+#if defined(LWRB_MULTI_PRODUCER)
+    LWRB_INIT(buff->w_rsv, 0);
+#endif /* defined(LWRB_MULTI_PRODUCER) */
+#if defined(LWRB_MULTI_CONSUMER)
+    LWRB_INIT(buff->r_rsv, 0);
+#endif /* defined(LWRB_MULTI_CONSUMER) */
+#if defined(LWRB_CACHELINE_ISOLATE)
+    buff->r_ptr_cache = 0;
+    buff->w_ptr_cache = 0;
+#endif /* defined(LWRB_CACHELINE_ISOLATE) */
+#if defined(LWRB_STATS)
+    prv_stats_init(&buff->w_stats);
+    prv_stats_init(&buff->r_stats);
+#endif /* defined(LWRB_STATS) */
+#if defined(LWRB_WAIT)
+    LWRB_INIT(buff->w_seq, 0);
+    LWRB_INIT(buff->r_wait, 0);
+    LWRB_INIT(buff->r_seq, 0);
+    LWRB_INIT(buff->w_wait, 0);
+#endif /* defined(LWRB_WAIT) */
     return 1;
 }
 
@@ -93,7 +735,7 @@ lwrb_init(lwrb_t* buff, void* buffdata, lwrb_sz_t size) {
  * \param[in]       buff: Ring buffer instance
  * \return          `1` if ready, `0` otherwise
  */
-uint8_t
+LWRB_API uint8_t
 lwrb_is_ready(lwrb_t* buff) {
     return BUF_IS_VALID(buff);
 }
@@ -104,7 +746,7 @@ lwrb_is_ready(lwrb_t* buff) {
  *                  it just sets buffer handle to `NULL`
  * \param[in]       buff: Ring buffer instance
  */
-void
+LWRB_API void
 lwrb_free(lwrb_t* buff) {
     if (BUF_IS_VALID(buff)) {
         buff->buff = NULL;
@@ -119,13 +761,44 @@ lwrb_free(lwrb_t* buff) {
  * \param[in]       buff: Ring buffer instance
  * \param[in]       evt_fn: Callback function
  */
-void
+LWRB_API void
 lwrb_set_evt_fn(lwrb_t* buff, lwrb_evt_fn evt_fn) {
     if (BUF_IS_VALID(buff)) {
         buff->evt_fn = evt_fn;
     }
 }
 
+#if defined(LWRB_EVT_WATERMARK) || __DOXYGEN__
+
+/**
+ * \brief           Set watermarks for edge-triggered events.
+ *
+ * When set, \ref LWRB_EVT_READ and \ref LWRB_EVT_WRITE events are no longer sent for every operation.
+ * Instead, \ref LWRB_EVT_HIGH_WATERMARK is sent when write makes number of bytes in the buffer
+ * rise from below `high` to `high` or more, and \ref LWRB_EVT_LOW_WATERMARK is sent when read makes it
+ * drop from above `low` to `low` or less. Event argument is number of bytes in the buffer.
+ *
+ * Use `high = 1` for "became non-empty" and `low = 0` for "became empty" events.
+ *
+ * \note            Not thread safe, set it during setup, same as \ref lwrb_set_evt_fn
+ * \param[in]       buff: Ring buffer instance
+ * \param[in]       low: Low watermark in units of bytes
+ * \param[in]       high: High watermark in units of bytes, must be greater than `low`.
+ *                      Set both to `0` to send event for every operation again
+ * \return          `1` on success, `0` otherwise
+ */
+LWRB_API uint8_t
+lwrb_set_evt_watermarks(lwrb_t* buff, lwrb_sz_t low, lwrb_sz_t high) {
+    if (!BUF_IS_VALID(buff) || (high <= low && high != 0) || (high == 0 && low != 0)) {
+        return 0;
+    }
+    buff->evt_low = low;
+    buff->evt_high = high;
+    return 1;
+}
+
+#endif /* defined(LWRB_EVT_WATERMARK) || __DOXYGEN__ */
+
 /**
  * \brief           Set custom buffer argument, that can be retrieved in the event function
  * \note            Not thread safe, and not meant to be. Set it once during setup,
@@ -134,7 +807,7 @@ lwrb_set_evt_fn(lwrb_t* buff, lwrb_evt_fn evt_fn) {
  * \param[in]       buff: Ring buffer instance
  * \param[in]       arg: Custom user argument
  */
-void
+LWRB_API void
 lwrb_set_arg(lwrb_t* buff, void* arg) {
     if (BUF_IS_VALID(buff)) {
         buff->arg = arg;
@@ -146,7 +819,7 @@ lwrb_set_arg(lwrb_t* buff, void* arg) {
  * \param[in]       buff: Ring buffer instance
  * \return          User argument, previously set with \ref lwrb_set_arg
  */
-void*
+LWRB_API void*
 lwrb_get_arg(lwrb_t* buff) {
     return buff != NULL ? buff->arg : NULL;
 }
@@ -168,7 +841,7 @@ lwrb_get_arg(lwrb_t* buff) {
  *                      When returned value is less than `btw`, there was no enough memory available
  *                      to copy full data array.
  */
-lwrb_sz_t
+LWRB_API lwrb_sz_t
 lwrb_write(lwrb_t* buff, const void* data, lwrb_sz_t btw) {
     lwrb_sz_t written = 0;
 
@@ -190,9 +863,9 @@ lwrb_write(lwrb_t* buff, const void* data, lwrb_sz_t btw) {
  *                          Will early return if no memory available
  * \return          `1` if write operation OK, `0` otherwise
  */
-uint8_t
+LWRB_API uint8_t
 lwrb_write_ex(lwrb_t* buff, const void* data, lwrb_sz_t btw, lwrb_sz_t* bwritten, uint16_t flags) {
-    lwrb_sz_t tocopy = 0, free = 0, w_ptr = 0;
+    lwrb_sz_t free = 0, w_ptr = 0;
     const uint8_t* d_ptr = data;
 
     if (!BUF_IS_VALID(buff) || data == NULL || btw == 0) {
@@ -200,125 +873,515 @@ lwrb_write_ex(lwrb_t* buff, const void* data, lwrb_sz_t btw, lwrb_sz_t* bwritten
     }
 
     /* Calculate maximum number of bytes available to write */
-    free = lwrb_get_free(buff);
+    free = BUF_GET_FREE(buff, btw);
     /* If no memory, or if user wants to write ALL data but no enough space, exit early */
     if (free == 0 || (free < btw && (flags & LWRB_FLAG_WRITE_ALL))) {
+        BUF_STATS_W_REQ(buff, btw, 0);
         return 0;
     }
+    BUF_STATS_W_REQ(buff, btw, free);
     btw = BUF_MIN(free, btw);
     w_ptr = LWRB_LOAD(buff->w_ptr, memory_order_acquire);
 
-    /* Step 1: Write data to linear part of buffer */
-    tocopy = BUF_MIN(buff->size - w_ptr, btw);
-    BUF_MEMCPY(&buff->buff[w_ptr], d_ptr, tocopy);
-    d_ptr += tocopy;
-    w_ptr += tocopy;
-    btw -= tocopy;
-
-    /* Step 2: Write data to beginning of buffer (overflow part) */
-    if (btw > 0) {
-        BUF_MEMCPY(buff->buff, d_ptr, btw);
-        w_ptr = btw;
-    }
+    /* Step 1: Write data to linear part of buffer, then to beginning of buffer (overflow part) */
+    prv_copy_to_buff(buff, w_ptr, d_ptr, btw);
 
-    /* Step 3: Check end of buffer */
-    if (w_ptr >= buff->size) {
-        w_ptr = 0;
-    }
+    /* Step 2: Advance write pointer, wrap at the end of buffer */
+    w_ptr = BUF_PTR_ADD(buff, w_ptr, btw);
 
     /*
      * Write final value to the actual running variable.
      * This is to ensure no read operation can access intermediate data
      */
     LWRB_STORE(buff->w_ptr, w_ptr, memory_order_release);
+    BUF_SYNC_W_RSV(buff, w_ptr);
 
-    BUF_SEND_EVT(buff, LWRB_EVT_WRITE, tocopy + btw);
+    BUF_SEND_EVT(buff, LWRB_EVT_WRITE, btw, BUF_FULL_AFTER_WRITE(buff, free, btw));
     if (bwritten != NULL) {
-        *bwritten = tocopy + btw;
+        *bwritten = btw;
     }
     return 1;
 }
 
+#if defined(LWRB_MULTI_PRODUCER) || __DOXYGEN__
+
 /**
- * \brief           Read data from buffer.
- *                  Copies data from `data` array to buffer and advances the read pointer for a maximum of `btr` number of bytes.
- * 
- *                  It copies less if there is less data available in the buffer.
- * 
- * \note            Use \ref lwrb_read_ex for more advanced usage
+ * \brief           Write data to buffer from multiple producers.
+ *                  Same as \ref lwrb_write, but safe to be called from
+ *                  several threads at the same time, without external lock.
+ *
+ * \note            Use \ref lwrb_write_mp_ex for more advanced usage
  *
  * \param[in]       buff: Ring buffer instance
- * \param[out]      data: Pointer to output memory to copy buffer data to
- * \param[in]       btr: Number of bytes to read
- * \return          Number of bytes read and copied to data array
+ * \param[in]       data: Pointer to data to write into buffer
+ * \param[in]       btw: Number of bytes to write
+ * \return          Number of bytes written to buffer.
+ *                      When returned value is less than `btw`, there was no enough memory available
+ *                      to copy full data array.
  */
-lwrb_sz_t
-lwrb_read(lwrb_t* buff, void* data, lwrb_sz_t btr) {
-    lwrb_sz_t read = 0;
+LWRB_API lwrb_sz_t
+lwrb_write_mp(lwrb_t* buff, const void* data, lwrb_sz_t btw) {
+    lwrb_sz_t written = 0;
 
-    if (lwrb_read_ex(buff, data, btr, &read, 0)) {
-        return read;
+    if (lwrb_write_mp_ex(buff, data, btw, &written, 0)) {
+        return written;
     }
     return 0;
 }
 
 /**
- * \brief           Read extended functionality
- * 
+ * \brief           Multi-producer write extended functionality
+ *
+ * Producer first reserves memory by atomically advancing `w_rsv` pointer (compare-and-swap),
+ * then copies data to the reserved memory in parallel with other producers,
+ * and at the end publishes data by advancing `w` pointer.
+ * Publish is done in the same order as reservations, hence producer waits
+ * for all the producers that reserved memory before it, to publish their data first.
+ *
+ * Consumer side uses default read functions, such as \ref lwrb_read or \ref lwrb_skip.
+ *
+ * \note            Lock-free only for reservation part. Producer preempted between reservation and publish
+ *                      will delay publish of all producers that reserved memory after it.
+ * \note            Event function is called from the producer context, possibly from several
+ *                      producers at the same time.
+ *
  * \param           buff: Ring buffer instance
- * \param           data: Pointer to memory to write read data from buffer 
- * \param           btr: Number of bytes to read
- * \param           bread: Output pointer to write number of bytes read from buffer and written to the 
- *                      output `data` variable
- * \param           flags: Optional flags
- *                      \ref LWRB_FLAG_READ_ALL: Request to read all data (up to btr).
- *                          Will early return if no enough bytes in the buffer
- * \return          `1` if read operation OK, `0` otherwise
- */
-uint8_t
-lwrb_read_ex(lwrb_t* buff, void* data, lwrb_sz_t btr, lwrb_sz_t* bread, uint16_t flags) {
-    lwrb_sz_t tocopy = 0, full = 0, r_ptr = 0;
-    uint8_t* d_ptr = data;
-
-    if (!BUF_IS_VALID(buff) || data == NULL || btr == 0) {
+ * \param           data: Pointer to data to write into buffer
+ * \param           btw: Number of bytes to write
+ * \param           bwritten: Output pointer to write number of bytes written into the buffer
+ * \param           flags: Optional flags.
+ *                      \ref LWRB_FLAG_WRITE_ALL: Request to write all data (up to btw).
+ *                          Will early return if no memory available
+ * \return          `1` if write operation OK, `0` otherwise
+ */
+LWRB_API uint8_t
+lwrb_write_mp_ex(lwrb_t* buff, const void* data, lwrb_sz_t btw, lwrb_sz_t* bwritten, uint16_t flags) {
+    lwrb_sz_t tocopy = 0, free = 0, rsv = 0, rsv_next = 0, r_ptr = 0;
+    const uint8_t* d_ptr = data;
+
+    if (!BUF_IS_VALID(buff) || data == NULL || btw == 0) {
+        return 0;
+    }
+
+    /*
+     * Step 1: Reserve memory.
+     *
+     * Read pointer is loaded after the reservation pointer. If other producers and consumer
+     * moved pointers in-between, calculated free memory may be invalid, but then
+     * reservation pointer changed too and compare-and-swap operation fails.
+     */
+    rsv = LWRB_LOAD(buff->w_rsv, memory_order_relaxed);
+    while (1) {
+        r_ptr = LWRB_LOAD(buff->r_ptr, memory_order_acquire);
+        free = prv_calc_free(buff, rsv, r_ptr);
+
+        /* If no memory, or if user wants to write ALL data but no enough space, exit early */
+        if (free == 0 || (free < btw && (flags & LWRB_FLAG_WRITE_ALL))) {
+            lwrb_sz_t rsv_now = LWRB_LOAD(buff->w_rsv, memory_order_relaxed);
+            if (rsv_now == rsv) {
+                BUF_STATS_W_REQ(buff, btw, 0);
+                return 0;
+            }
+            rsv = rsv_now; /* Calculation used outdated pointer, try again */
+            continue;
+        }
+        tocopy = BUF_MIN(free, btw);
+        rsv_next = BUF_PTR_ADD(buff, rsv, tocopy);
+        if (atomic_compare_exchange_weak_explicit(&buff->w_rsv, &rsv, rsv_next, memory_order_relaxed,
+                                                  memory_order_relaxed)) {
+            break;
+        }
+    }
+    BUF_STATS_W_REQ(buff, btw, free);
+    btw = tocopy;
+
+    /* Step 2: Copy data to reserved memory, linear part and overflow part */
+    prv_copy_to_buff(buff, rsv, d_ptr, btw);
+
+    /*
+     * Step 3: Wait for previous producers to publish, then publish own data.
+     *
+     * Acquire load makes data of previous producers visible before own release,
+     * so consumer synchronizing with the last publish sees data of all of them
+     */
+    while (LWRB_LOAD(buff->w_ptr, memory_order_acquire) != rsv) {
+        LWRB_CPU_RELAX();
+    }
+    LWRB_STORE(buff->w_ptr, rsv_next, memory_order_release);
+
+    BUF_SEND_EVT(buff, LWRB_EVT_WRITE, btw, prv_calc_full(buff, rsv_next, r_ptr));
+    if (bwritten != NULL) {
+        *bwritten = btw;
+    }
+    return 1;
+}
+
+#endif /* defined(LWRB_MULTI_PRODUCER) || __DOXYGEN__ */
+
+/**
+ * \brief           Read data from buffer.
+ *                  Copies data from `data` array to buffer and advances the read pointer for a maximum of `btr` number of bytes.
+ * 
+ *                  It copies less if there is less data available in the buffer.
+ * 
+ * \note            Use \ref lwrb_read_ex for more advanced usage
+ *
+ * \param[in]       buff: Ring buffer instance
+ * \param[out]      data: Pointer to output memory to copy buffer data to
+ * \param[in]       btr: Number of bytes to read
+ * \return          Number of bytes read and copied to data array
+ */
+LWRB_API lwrb_sz_t
+lwrb_read(lwrb_t* buff, void* data, lwrb_sz_t btr) {
+    lwrb_sz_t read = 0;
+
+    if (lwrb_read_ex(buff, data, btr, &read, 0)) {
+        return read;
+    }
+    return 0;
+}
+
+/**
+ * \brief           Read extended functionality
+ * 
+ * \param           buff: Ring buffer instance
+ * \param           data: Pointer to memory to write read data from buffer 
+ * \param           btr: Number of bytes to read
+ * \param           bread: Output pointer to write number of bytes read from buffer and written to the 
+ *                      output `data` variable
+ * \param           flags: Optional flags
+ *                      \ref LWRB_FLAG_READ_ALL: Request to read all data (up to btr).
+ *                          Will early return if no enough bytes in the buffer
+ * \return          `1` if read operation OK, `0` otherwise
+ */
+LWRB_API uint8_t
+lwrb_read_ex(lwrb_t* buff, void* data, lwrb_sz_t btr, lwrb_sz_t* bread, uint16_t flags) {
+    lwrb_sz_t full = 0, r_ptr = 0;
+    uint8_t* d_ptr = data;
+
+    if (!BUF_IS_VALID(buff) || data == NULL || btr == 0) {
         return 0;
     }
 
     /* Calculate maximum number of bytes available to read */
-    full = lwrb_get_full(buff);
+    full = BUF_GET_FULL(buff, btr);
     if (full == 0 || (full < btr && (flags & LWRB_FLAG_READ_ALL))) {
+        BUF_STATS_R_REQ(buff, btr, 0);
         return 0;
     }
+    BUF_STATS_R_REQ(buff, btr, full);
     btr = BUF_MIN(full, btr);
     r_ptr = LWRB_LOAD(buff->r_ptr, memory_order_acquire);
 
-    /* Step 1: Read data from linear part of buffer */
-    tocopy = BUF_MIN(buff->size - r_ptr, btr);
-    BUF_MEMCPY(d_ptr, &buff->buff[r_ptr], tocopy);
-    d_ptr += tocopy;
-    r_ptr += tocopy;
-    btr -= tocopy;
+    /* Step 1: Read data from linear part of buffer, then from beginning of buffer (overflow part) */
+    prv_copy_from_buff(buff, r_ptr, d_ptr, btr);
+
+    /* Step 2: Advance read pointer, wrap at the end of buffer */
+    r_ptr = BUF_PTR_ADD(buff, r_ptr, btr);
+
+    /*
+     * Write final value to the actual running variable.
+     * This is to ensure no write operation can access intermediate data
+     */
+    LWRB_STORE(buff->r_ptr, r_ptr, memory_order_release);
+    BUF_SYNC_R_RSV(buff, r_ptr);
+
+    BUF_SEND_EVT(buff, LWRB_EVT_READ, btr, full - btr);
+    if (bread != NULL) {
+        *bread = btr;
+    }
+    return 1;
+}
+
+#if defined(LWRB_MULTI_CONSUMER) || __DOXYGEN__
+
+/**
+ * \brief           Read data from buffer from multiple consumers.
+ *                  Same as \ref lwrb_read, but safe to be called from
+ *                  several threads at the same time, without external lock.
+ *
+ * \note            Use \ref lwrb_read_mc_ex for more advanced usage
+ *
+ * \param[in]       buff: Ring buffer instance
+ * \param[out]      data: Pointer to output memory to copy buffer data to
+ * \param[in]       btr: Number of bytes to read
+ * \return          Number of bytes read and copied to data array
+ */
+LWRB_API lwrb_sz_t
+lwrb_read_mc(lwrb_t* buff, void* data, lwrb_sz_t btr) {
+    lwrb_sz_t read = 0;
 
-    /* Step 2: Read data from beginning of buffer (overflow part) */
-    if (btr > 0) {
-        BUF_MEMCPY(d_ptr, buff->buff, btr);
-        r_ptr = btr;
+    if (lwrb_read_mc_ex(buff, data, btr, &read, 0)) {
+        return read;
     }
+    return 0;
+}
+
+/**
+ * \brief           Multi-consumer read extended functionality
+ *
+ * Consumer first claims data by atomically advancing `r_rsv` pointer (compare-and-swap),
+ * so that every consumer gets its own, disjoint, part of the buffer.
+ * It then copies data in parallel with other consumers, and at the end releases memory
+ * back to producer by advancing `r` pointer.
+ * Release is done in the same order as claims, hence consumer waits
+ * for all the consumers that claimed data before it, to release their memory first.
+ *
+ * Producer side uses default write functions, or multi-producer write functions
+ * when `LWRB_MULTI_PRODUCER` is defined too.
+ *
+ * \note            Lock-free only for claim part. Consumer preempted between claim and release
+ *                      will delay release of all consumers that claimed data after it.
+ * \note            Functions \ref lwrb_peek, \ref lwrb_find and linear block read functions
+ *                      do not take claimed data into account and must not be used with multiple consumers.
+ * \note            Claim relies on free running pointers of `LWRB_POW2` mode.
+ *                      Pointers wrapping at buffer size would let consumer with outdated `full` value
+ *                      claim data, that was already consumed and rewritten
+ *
+ * \param           buff: Ring buffer instance
+ * \param           data: Pointer to memory to write read data from buffer
+ * \param           btr: Number of bytes to read
+ * \param           bread: Output pointer to write number of bytes read from buffer and written to the
+ *                      output `data` variable
+ * \param           flags: Optional flags
+ *                      \ref LWRB_FLAG_READ_ALL: Request to read all data (up to btr).
+ *                          Will early return if no enough bytes in the buffer
+ * \return          `1` if read operation OK, `0` otherwise
+ */
+LWRB_API uint8_t
+lwrb_read_mc_ex(lwrb_t* buff, void* data, lwrb_sz_t btr, lwrb_sz_t* bread, uint16_t flags) {
+    lwrb_sz_t tocopy = 0, full = 0, rsv = 0, rsv_next = 0, w_ptr = 0;
+    uint8_t* d_ptr = data;
 
-    /* Step 3: Check end of buffer */
-    if (r_ptr >= buff->size) {
-        r_ptr = 0;
+    if (!BUF_IS_VALID(buff) || data == NULL || btr == 0) {
+        return 0;
     }
 
     /*
-     * Write final value to the actual running variable.
-     * This is to ensure no write operation can access intermediate data
+     * Step 1: Claim data.
+     *
+     * Write pointer is loaded after the reservation pointer.
+     * See lwrb_write_mp_ex for more information why this is OK.
+     */
+    rsv = LWRB_LOAD(buff->r_rsv, memory_order_relaxed);
+    while (1) {
+        w_ptr = LWRB_LOAD(buff->w_ptr, memory_order_acquire);
+        full = prv_calc_full(buff, w_ptr, rsv);
+
+        /* If no data, or if user wants to read ALL data but no enough data, exit early */
+        if (full == 0 || (full < btr && (flags & LWRB_FLAG_READ_ALL))) {
+            lwrb_sz_t rsv_now = LWRB_LOAD(buff->r_rsv, memory_order_relaxed);
+            if (rsv_now == rsv) {
+                BUF_STATS_R_REQ(buff, btr, 0);
+                return 0;
+            }
+            rsv = rsv_now; /* Calculation used outdated pointer, try again */
+            continue;
+        }
+        tocopy = BUF_MIN(full, btr);
+        rsv_next = BUF_PTR_ADD(buff, rsv, tocopy);
+        if (atomic_compare_exchange_weak_explicit(&buff->r_rsv, &rsv, rsv_next, memory_order_relaxed,
+                                                  memory_order_relaxed)) {
+            break;
+        }
+    }
+    BUF_STATS_R_REQ(buff, btr, full);
+    btr = tocopy;
+
+    /* Step 2: Copy claimed data, linear part and overflow part */
+    prv_copy_from_buff(buff, rsv, d_ptr, btr);
+
+    /*
+     * Step 3: Wait for previous consumers to release, then release own memory.
+     * See lwrb_write_mp_ex for memory ordering explanation
      */
+    while (LWRB_LOAD(buff->r_ptr, memory_order_acquire) != rsv) {
+        LWRB_CPU_RELAX();
+    }
+    LWRB_STORE(buff->r_ptr, rsv_next, memory_order_release);
+
+    BUF_SEND_EVT(buff, LWRB_EVT_READ, btr, prv_calc_full(buff, w_ptr, rsv_next));
+    if (bread != NULL) {
+        *bread = btr;
+    }
+    return 1;
+}
+
+#endif /* defined(LWRB_MULTI_CONSUMER) || __DOXYGEN__ */
+
+/**
+ * \brief           Get total length of all vector entries
+ * \param[in]       iov: Array of vector entries
+ * \param[in]       iovcnt: Number of entries in array
+ * \return          Sum of lengths of all entries with valid data pointer
+ */
+static lwrb_sz_t
+prv_iov_len(const lwrb_iovec_t* iov, size_t iovcnt) {
+    lwrb_sz_t len = 0;
+
+    for (size_t i = 0; i < iovcnt; ++i) {
+        if (iov[i].data != NULL) {
+            len += iov[i].len;
+        }
+    }
+    return len;
+}
+
+/**
+ * \brief           Write data from multiple memory blocks to buffer (gather write).
+ *
+ * \note            Use \ref lwrb_writev_ex for more advanced usage
+ *
+ * \param[in]       buff: Ring buffer instance
+ * \param[in]       iov: Array of memory blocks to write, in order
+ * \param[in]       iovcnt: Number of entries in `iov` array
+ * \return          Number of bytes written to buffer
+ */
+LWRB_API lwrb_sz_t
+lwrb_writev(lwrb_t* buff, const lwrb_iovec_t* iov, size_t iovcnt) {
+    lwrb_sz_t written = 0;
+
+    if (lwrb_writev_ex(buff, iov, iovcnt, &written, 0)) {
+        return written;
+    }
+    return 0;
+}
+
+/**
+ * \brief           Write from multiple memory blocks extended functionality
+ *
+ * All blocks are written as one operation. Pointers are loaded once,
+ * write pointer is published once after all blocks are copied and event is sent once,
+ * hence read side can never see only part of the blocks written
+ *
+ * \param           buff: Ring buffer instance
+ * \param           iov: Array of memory blocks to write, in order
+ * \param           iovcnt: Number of entries in `iov` array
+ * \param           bwritten: Output pointer to write number of bytes written into the buffer
+ * \param           flags: Optional flags.
+ *                      \ref LWRB_FLAG_WRITE_ALL: Request to write all blocks completely.
+ *                          Will early return if no memory available
+ * \return          `1` if write operation OK, `0` otherwise
+ */
+LWRB_API uint8_t
+lwrb_writev_ex(lwrb_t* buff, const lwrb_iovec_t* iov, size_t iovcnt, lwrb_sz_t* bwritten, uint16_t flags) {
+    lwrb_sz_t btw = 0, free = 0, w_ptr = 0, tocopy = 0, written = 0;
+
+    if (!BUF_IS_VALID(buff) || iov == NULL || iovcnt == 0) {
+        return 0;
+    }
+    btw = prv_iov_len(iov, iovcnt);
+    if (btw == 0) {
+        return 0;
+    }
+
+    /* Calculate maximum number of bytes available to write */
+    free = BUF_GET_FREE(buff, btw);
+    if (free == 0 || (free < btw && (flags & LWRB_FLAG_WRITE_ALL))) {
+        BUF_STATS_W_REQ(buff, btw, 0);
+        return 0;
+    }
+    BUF_STATS_W_REQ(buff, btw, free);
+    btw = BUF_MIN(free, btw);
+    w_ptr = LWRB_LOAD(buff->w_ptr, memory_order_acquire);
+
+    /* Copy blocks one after another, stop when there is no more memory */
+    for (size_t i = 0; i < iovcnt && written < btw; ++i) {
+        if (iov[i].data == NULL) {
+            continue;
+        }
+        tocopy = BUF_MIN(iov[i].len, btw - written);
+        prv_copy_to_buff(buff, BUF_PTR_ADD(buff, w_ptr, written), iov[i].data, tocopy);
+        written += tocopy;
+    }
+
+    /* Publish all blocks at once */
+    w_ptr = BUF_PTR_ADD(buff, w_ptr, written);
+    LWRB_STORE(buff->w_ptr, w_ptr, memory_order_release);
+    BUF_SYNC_W_RSV(buff, w_ptr);
+
+    BUF_SEND_EVT(buff, LWRB_EVT_WRITE, written, BUF_FULL_AFTER_WRITE(buff, free, written));
+    if (bwritten != NULL) {
+        *bwritten = written;
+    }
+    return 1;
+}
+
+/**
+ * \brief           Read data from buffer to multiple memory blocks (scatter read).
+ *
+ * \note            Use \ref lwrb_readv_ex for more advanced usage
+ *
+ * \param[in]       buff: Ring buffer instance
+ * \param[in]       iov: Array of memory blocks to fill, in order
+ * \param[in]       iovcnt: Number of entries in `iov` array
+ * \return          Number of bytes read from buffer
+ */
+LWRB_API lwrb_sz_t
+lwrb_readv(lwrb_t* buff, const lwrb_iovec_t* iov, size_t iovcnt) {
+    lwrb_sz_t read = 0;
+
+    if (lwrb_readv_ex(buff, iov, iovcnt, &read, 0)) {
+        return read;
+    }
+    return 0;
+}
+
+/**
+ * \brief           Read to multiple memory blocks extended functionality
+ *
+ * Blocks are filled one after another as one operation. Pointers are loaded once,
+ * read pointer is published once after all blocks are copied and event is sent once.
+ *
+ * \param           buff: Ring buffer instance
+ * \param           iov: Array of memory blocks to fill, in order
+ * \param           iovcnt: Number of entries in `iov` array
+ * \param           bread: Output pointer to write number of bytes read from buffer
+ * \param           flags: Optional flags
+ *                      \ref LWRB_FLAG_READ_ALL: Request to fill all blocks completely.
+ *                          Will early return if no enough bytes in the buffer
+ * \return          `1` if read operation OK, `0` otherwise
+ */
+LWRB_API uint8_t
+lwrb_readv_ex(lwrb_t* buff, const lwrb_iovec_t* iov, size_t iovcnt, lwrb_sz_t* bread, uint16_t flags) {
+    lwrb_sz_t btr = 0, full = 0, r_ptr = 0, tocopy = 0, read = 0;
+
+    if (!BUF_IS_VALID(buff) || iov == NULL || iovcnt == 0) {
+        return 0;
+    }
+    btr = prv_iov_len(iov, iovcnt);
+    if (btr == 0) {
+        return 0;
+    }
+
+    /* Calculate maximum number of bytes available to read */
+    full = BUF_GET_FULL(buff, btr);
+    if (full == 0 || (full < btr && (flags & LWRB_FLAG_READ_ALL))) {
+        BUF_STATS_R_REQ(buff, btr, 0);
+        return 0;
+    }
+    BUF_STATS_R_REQ(buff, btr, full);
+    btr = BUF_MIN(full, btr);
+    r_ptr = LWRB_LOAD(buff->r_ptr, memory_order_acquire);
+
+    /* Fill blocks one after another, stop when there is no more data */
+    for (size_t i = 0; i < iovcnt && read < btr; ++i) {
+        if (iov[i].data == NULL) {
+            continue;
+        }
+        tocopy = BUF_MIN(iov[i].len, btr - read);
+        prv_copy_from_buff(buff, BUF_PTR_ADD(buff, r_ptr, read), iov[i].data, tocopy);
+        read += tocopy;
+    }
+
+    /* Release memory of all blocks at once */
+    r_ptr = BUF_PTR_ADD(buff, r_ptr, read);
     LWRB_STORE(buff->r_ptr, r_ptr, memory_order_release);
+    BUF_SYNC_R_RSV(buff, r_ptr);
 
-    BUF_SEND_EVT(buff, LWRB_EVT_READ, tocopy + btr);
+    BUF_SEND_EVT(buff, LWRB_EVT_READ, read, full - read);
     if (bread != NULL) {
-        *bread = tocopy + btr;
+        *bread = read;
     }
     return 1;
 }
@@ -335,7 +1398,7 @@ lwrb_read_ex(lwrb_t* buff, void* data, lwrb_sz_t btr, lwrb_sz_t* bread, uint16_t
  * \param[in]       btp: Number of bytes to peek
  * \return          Number of bytes peeked and written to output array
  */
-lwrb_sz_t
+LWRB_API lwrb_sz_t
 lwrb_peek(const lwrb_t* buff, lwrb_sz_t skip_count, void* data, lwrb_sz_t btp) {
     lwrb_sz_t full = 0, tocopy = 0, r_ptr = 0;
     uint8_t* d_ptr = data;
@@ -356,15 +1419,12 @@ lwrb_peek(const lwrb_t* buff, lwrb_sz_t skip_count, void* data, lwrb_sz_t btp) {
         return 0;
     }
     r_ptr = LWRB_LOAD(buff->r_ptr, memory_order_relaxed);
-    r_ptr += skip_count;
+    r_ptr = BUF_IDX(buff, BUF_PTR_ADD(buff, r_ptr, skip_count));
     full -= skip_count;
-    if (r_ptr >= buff->size) {
-        r_ptr -= buff->size;
-    }
     btp = BUF_MIN(full, btp);
 
     /* Step 1: Read data from linear part of the buffer */
-    tocopy = BUF_MIN(buff->size - r_ptr, btp);
+    tocopy = BUF_MIN(BUF_LIN_END(buff) - r_ptr, btp);
     BUF_MEMCPY(d_ptr, &buff->buff[r_ptr], tocopy);
     d_ptr += tocopy;
     btp -= tocopy;
@@ -381,9 +1441,9 @@ lwrb_peek(const lwrb_t* buff, lwrb_sz_t skip_count, void* data, lwrb_sz_t btp) {
  * \param[in]       buff: Ring buffer instance
  * \return          Number of free bytes in memory
  */
-lwrb_sz_t
+LWRB_API lwrb_sz_t
 lwrb_get_free(const lwrb_t* buff) {
-    lwrb_sz_t size = 0, w_ptr = 0, r_ptr = 0;
+    lwrb_sz_t w_ptr = 0, r_ptr = 0;
 
     if (!BUF_IS_VALID(buff)) {
         return 0;
@@ -409,15 +1469,7 @@ lwrb_get_free(const lwrb_t* buff) {
      */
     w_ptr = LWRB_LOAD(buff->w_ptr, memory_order_relaxed);
     r_ptr = LWRB_LOAD(buff->r_ptr, memory_order_acquire);
-
-    if (w_ptr >= r_ptr) {
-        size = buff->size - (w_ptr - r_ptr);
-    } else {
-        size = r_ptr - w_ptr;
-    }
-
-    /* Buffer free size is always 1 less than actual size */
-    return size - 1;
+    return prv_calc_free(buff, w_ptr, r_ptr);
 }
 
 /**
@@ -425,9 +1477,9 @@ lwrb_get_free(const lwrb_t* buff) {
  * \param[in]       buff: Ring buffer instance
  * \return          Number of bytes ready to be read
  */
-lwrb_sz_t
+LWRB_API lwrb_sz_t
 lwrb_get_full(const lwrb_t* buff) {
-    lwrb_sz_t size = 0, w_ptr = 0, r_ptr = 0;
+    lwrb_sz_t w_ptr = 0, r_ptr = 0;
 
     if (!BUF_IS_VALID(buff)) {
         return 0;
@@ -453,13 +1505,7 @@ lwrb_get_full(const lwrb_t* buff) {
      */
     w_ptr = LWRB_LOAD(buff->w_ptr, memory_order_acquire);
     r_ptr = LWRB_LOAD(buff->r_ptr, memory_order_relaxed);
-
-    if (w_ptr >= r_ptr) {
-        size = w_ptr - r_ptr;
-    } else {
-        size = buff->size - (r_ptr - w_ptr);
-    }
-    return size;
+    return prv_calc_full(buff, w_ptr, r_ptr);
 }
 
 /**
@@ -468,12 +1514,21 @@ lwrb_get_full(const lwrb_t* buff) {
  *                      When used, application must ensure there is no active read/write operation
  * \param[in]       buff: Ring buffer instance
  */
-void
+LWRB_API void
 lwrb_reset(lwrb_t* buff) {
     if (BUF_IS_VALID(buff)) {
         LWRB_STORE(buff->w_ptr, 0, memory_order_release);
         LWRB_STORE(buff->r_ptr, 0, memory_order_release);
-        BUF_SEND_EVT(buff, LWRB_EVT_RESET, 0);
+        BUF_SYNC_W_RSV(buff, 0);
+        BUF_SYNC_R_RSV(buff, 0);
+#if defined(LWRB_LOSSY)
+        LWRB_STORE(buff->w_head, 0, memory_order_release);
+#endif /* defined(LWRB_LOSSY) */
+#if defined(LWRB_CACHELINE_ISOLATE)
+        buff->r_ptr_cache = 0;
+        buff->w_ptr_cache = 0;
+#endif /* defined(LWRB_CACHELINE_ISOLATE) */
+        BUF_SEND_EVT(buff, LWRB_EVT_RESET, 0, 0);
     }
 }
 
@@ -482,7 +1537,7 @@ lwrb_reset(lwrb_t* buff) {
  * \param[in]       buff: Ring buffer instance
  * \return          Linear buffer start address
  */
-void*
+LWRB_API void*
 lwrb_get_linear_block_read_address(const lwrb_t* buff) {
     lwrb_sz_t ptr = 0;
 
@@ -490,7 +1545,7 @@ lwrb_get_linear_block_read_address(const lwrb_t* buff) {
         return NULL;
     }
     ptr = LWRB_LOAD(buff->r_ptr, memory_order_relaxed);
-    return &buff->buff[ptr];
+    return &buff->buff[BUF_IDX(buff, ptr)];
 }
 
 /**
@@ -498,9 +1553,9 @@ lwrb_get_linear_block_read_address(const lwrb_t* buff) {
  * \param[in]       buff: Ring buffer instance
  * \return          Linear buffer size in units of bytes for read operation
  */
-lwrb_sz_t
+LWRB_API lwrb_sz_t
 lwrb_get_linear_block_read_length(const lwrb_t* buff) {
-    lwrb_sz_t len = 0, w_ptr = 0, r_ptr = 0;
+    lwrb_sz_t full = 0, w_ptr = 0, r_ptr = 0;
 
     if (!BUF_IS_VALID(buff)) {
         return 0;
@@ -509,18 +1564,14 @@ lwrb_get_linear_block_read_length(const lwrb_t* buff) {
     /*
      * Use temporary values in case they are changed during operations.
      * See lwrb_buff_free or lwrb_buff_full functions for more information why this is OK.
+     *
+     * Linear length is number of bytes in the buffer,
+     * limited by the distance of read pointer to the end of the buffer
      */
     w_ptr = LWRB_LOAD(buff->w_ptr, memory_order_acquire);
     r_ptr = LWRB_LOAD(buff->r_ptr, memory_order_relaxed);
-
-    if (w_ptr > r_ptr) {
-        len = w_ptr - r_ptr;
-    } else if (r_ptr > w_ptr) {
-        len = buff->size - r_ptr;
-    } else {
-        len = 0;
-    }
-    return len;
+    full = prv_calc_full(buff, w_ptr, r_ptr);
+    return BUF_MIN(full, BUF_LIN_END(buff) - BUF_IDX(buff, r_ptr));
 }
 
 /**
@@ -532,7 +1583,7 @@ lwrb_get_linear_block_read_length(const lwrb_t* buff) {
  * \param[in]       len: Number of bytes to skip and mark as read
  * \return          Number of bytes skipped
  */
-lwrb_sz_t
+LWRB_API lwrb_sz_t
 lwrb_skip(lwrb_t* buff, lwrb_sz_t len) {
     lwrb_sz_t full = 0, r_ptr = 0;
 
@@ -540,32 +1591,112 @@ lwrb_skip(lwrb_t* buff, lwrb_sz_t len) {
         return 0;
     }
 
-    full = lwrb_get_full(buff);
+    full = BUF_GET_FULL(buff, len);
+    BUF_STATS_R_REQ(buff, len, full);
     len = BUF_MIN(len, full);
     r_ptr = LWRB_LOAD(buff->r_ptr, memory_order_acquire);
-    r_ptr += len;
-    if (r_ptr >= buff->size) {
-        r_ptr -= buff->size;
-    }
+    r_ptr = BUF_PTR_ADD(buff, r_ptr, len);
     LWRB_STORE(buff->r_ptr, r_ptr, memory_order_release);
-    BUF_SEND_EVT(buff, LWRB_EVT_READ, len);
+    BUF_SYNC_R_RSV(buff, r_ptr);
+    BUF_SEND_EVT(buff, LWRB_EVT_READ, len, full - len);
     return len;
 }
 
+#if defined(LWRB_STATS)
+
 /**
- * \brief           Get linear address for buffer for fast write
+ * \brief           Remove oldest data on behalf of the producer, to make room for new data.
+ *
+ * Same as \ref lwrb_skip, but removed and `discarded` bytes are counted as dropped
+ * in write side statistics, not as read. Private to the library, used by \ref lwrb_overwrite
+ *
  * \param[in]       buff: Ring buffer instance
- * \return          Linear buffer start address
+ * \param[in]       len: Maximum number of bytes to remove from the buffer
+ * \param[in]       discarded: Number of input bytes, that producer dropped before they reached the buffer
+ * \return          Number of bytes removed from the buffer
  */
-void*
-lwrb_get_linear_block_write_address(const lwrb_t* buff) {
-    lwrb_sz_t ptr = 0;
+LWRB_API lwrb_sz_t
+lwrb_priv_drop(lwrb_t* buff, lwrb_sz_t len, lwrb_sz_t discarded) {
+    lwrb_sz_t full = 0, r_ptr = 0;
+
+    if (!BUF_IS_VALID(buff)) {
+        return 0;
+    }
+
+    full = BUF_GET_FULL(buff, len);
+    len = BUF_MIN(len, full);
+    if (len + discarded > 0) {
+        BUF_STATS_BEGIN(BUF_STATS_W_MULTI, &buff->w_stats);
+        BUF_STATS_ADD(BUF_STATS_W_MULTI, buff->w_stats.dropped, len + discarded);
+        BUF_STATS_END(BUF_STATS_W_MULTI, &buff->w_stats);
+    }
+    if (len == 0) {
+        return 0;
+    }
+    r_ptr = LWRB_LOAD(buff->r_ptr, memory_order_acquire);
+    r_ptr = BUF_PTR_ADD(buff, r_ptr, len);
+    LWRB_STORE(buff->r_ptr, r_ptr, memory_order_release);
+    BUF_SYNC_R_RSV(buff, r_ptr);
+    BUF_NOTIFY_EVT(buff, LWRB_EVT_READ, len, full - len);
+    return len;
+}
+
+#endif /* defined(LWRB_STATS) */
+
+/**
+ * \brief           Acquire data for zero-copy read, across the end of the buffer.
+ *
+ * Returns data in the buffer as up to `2` linear blocks (spans), calculated from single pointer snapshot.
+ * First span starts at read pointer, second span (if used) starts at the beginning of the buffer.
+ * Application processes data directly from the spans, then calls \ref lwrb_read_release
+ * to free processed bytes with single pointer update.
+ *
+ * \param[in]       buff: Ring buffer instance
+ * \param[in]       btr: Maximum number of bytes to acquire
+ * \param[out]      spans: Array of `2` entries, filled with acquired memory blocks
+ * \return          Number of bytes acquired, sum of both span lengths
+ */
+LWRB_API lwrb_sz_t
+lwrb_read_acquire(lwrb_t* buff, lwrb_sz_t btr, lwrb_iovec_t* spans) {
+    lwrb_sz_t full = 0, r_ptr = 0;
+
+    if (spans == NULL) {
+        return 0;
+    }
+    BUF_MEMSET(spans, 0x00, 2 * sizeof(*spans));
+    if (!BUF_IS_VALID(buff) || btr == 0) {
+        return 0;
+    }
+    full = BUF_GET_FULL(buff, btr);
+    r_ptr = LWRB_LOAD(buff->r_ptr, memory_order_relaxed);
+    return prv_get_spans(buff, r_ptr, BUF_MIN(full, btr), spans);
+}
+
+/**
+ * \brief           Release data acquired with \ref lwrb_read_acquire
+ * \param[in]       buff: Ring buffer instance
+ * \param[in]       len: Number of bytes processed, must not be greater than acquired length
+ * \return          Number of bytes released
+ */
+LWRB_API lwrb_sz_t
+lwrb_read_release(lwrb_t* buff, lwrb_sz_t len) {
+    return lwrb_skip(buff, len);
+}
+
+/**
+ * \brief           Get linear address for buffer for fast write
+ * \param[in]       buff: Ring buffer instance
+ * \return          Linear buffer start address
+ */
+LWRB_API void*
+lwrb_get_linear_block_write_address(const lwrb_t* buff) {
+    lwrb_sz_t ptr = 0;
 
     if (!BUF_IS_VALID(buff)) {
         return NULL;
     }
     ptr = LWRB_LOAD(buff->w_ptr, memory_order_relaxed);
-    return &buff->buff[ptr];
+    return &buff->buff[BUF_IDX(buff, ptr)];
 }
 
 /**
@@ -573,9 +1704,9 @@ lwrb_get_linear_block_write_address(const lwrb_t* buff) {
  * \param[in]       buff: Ring buffer instance
  * \return          Linear buffer size in units of bytes for write operation
  */
-lwrb_sz_t
+LWRB_API lwrb_sz_t
 lwrb_get_linear_block_write_length(const lwrb_t* buff) {
-    lwrb_sz_t len = 0, w_ptr = 0, r_ptr = 0;
+    lwrb_sz_t free = 0, w_ptr = 0, r_ptr = 0;
 
     if (!BUF_IS_VALID(buff)) {
         return 0;
@@ -584,29 +1715,20 @@ lwrb_get_linear_block_write_length(const lwrb_t* buff) {
     /*
      * Use temporary values in case they are changed during operations.
      * See lwrb_buff_free or lwrb_buff_full functions for more information why this is OK.
+     *
+     * Linear length is number of free bytes in the buffer,
+     * limited by the distance of write pointer to the end of the buffer.
+     * Free memory already accounts for the byte that must stay empty
+     * when read pointer is at the beginning of the buffer.
      */
     w_ptr = LWRB_LOAD(buff->w_ptr, memory_order_relaxed);
     r_ptr = LWRB_LOAD(buff->r_ptr, memory_order_acquire);
-
-    if (w_ptr >= r_ptr) {
-        len = buff->size - w_ptr;
-        /*
-         * When read pointer is 0,
-         * maximal length is one less as if too many bytes
-         * are written, buffer would be considered empty again (r == w)
-         */
-        if (r_ptr == 0) {
-            /*
-             * Cannot overflow:
-             * - If r is not 0, statement does not get called
-             * - buff->size cannot be 0 and if r is 0, len is greater 0
-             */
-            --len;
-        }
-    } else {
-        len = r_ptr - w_ptr - 1;
-    }
-    return len;
+    free = prv_calc_free(buff, w_ptr, r_ptr);
+#if defined(LWRB_ELEM)
+    /* Hand out whole element slots only, free memory is not a multiple of element size */
+    free -= free % buff->elem_size;
+#endif /* defined(LWRB_ELEM) */
+    return BUF_MIN(free, BUF_LIN_END(buff) - BUF_IDX(buff, w_ptr));
 }
 
 /**
@@ -619,7 +1741,7 @@ lwrb_get_linear_block_write_length(const lwrb_t* buff) {
  * \param[in]       len: Number of bytes to advance
  * \return          Number of bytes advanced for write operation
  */
-lwrb_sz_t
+LWRB_API lwrb_sz_t
 lwrb_advance(lwrb_t* buff, lwrb_sz_t len) {
     lwrb_sz_t free = 0, w_ptr = 0;
 
@@ -628,21 +1750,96 @@ lwrb_advance(lwrb_t* buff, lwrb_sz_t len) {
     }
 
     /* Use local variables before writing back to main structure */
-    free = lwrb_get_free(buff);
+    free = BUF_GET_FREE(buff, len);
+    BUF_STATS_W_REQ(buff, len, free);
     len = BUF_MIN(len, free);
     w_ptr = LWRB_LOAD(buff->w_ptr, memory_order_acquire);
-    w_ptr += len;
-    if (w_ptr >= buff->size) {
-        w_ptr -= buff->size;
-    }
+    w_ptr = BUF_PTR_ADD(buff, w_ptr, len);
     LWRB_STORE(buff->w_ptr, w_ptr, memory_order_release);
-    BUF_SEND_EVT(buff, LWRB_EVT_WRITE, len);
+    BUF_SYNC_W_RSV(buff, w_ptr);
+    BUF_SEND_EVT(buff, LWRB_EVT_WRITE, len, BUF_FULL_AFTER_WRITE(buff, free, len));
     return len;
 }
 
+/**
+ * \brief           Reserve memory for zero-copy write, across the end of the buffer.
+ *
+ * Returns free memory as up to `2` linear blocks (spans), calculated from single pointer snapshot.
+ * First span starts at write pointer, second span (if used) starts at the beginning of the buffer.
+ * Application writes data directly to the spans, then calls \ref lwrb_write_commit
+ * to publish written bytes with single pointer update.
+ *
+ * \note            Reservation does not modify the buffer. Data becomes visible to read side only after commit.
+ * \param[in]       buff: Ring buffer instance
+ * \param[in]       btw: Maximum number of bytes to reserve
+ * \param[out]      spans: Array of `2` entries, filled with reserved memory blocks
+ * \return          Number of bytes reserved, sum of both span lengths
+ */
+LWRB_API lwrb_sz_t
+lwrb_write_reserve(lwrb_t* buff, lwrb_sz_t btw, lwrb_iovec_t* spans) {
+    lwrb_sz_t free = 0, w_ptr = 0;
+
+    if (spans == NULL) {
+        return 0;
+    }
+    BUF_MEMSET(spans, 0x00, 2 * sizeof(*spans));
+    if (!BUF_IS_VALID(buff) || btw == 0) {
+        return 0;
+    }
+    free = BUF_GET_FREE(buff, btw);
+    w_ptr = LWRB_LOAD(buff->w_ptr, memory_order_relaxed);
+    return prv_get_spans(buff, w_ptr, BUF_MIN(free, btw), spans);
+}
+
+/**
+ * \brief           Commit data written to memory reserved with \ref lwrb_write_reserve
+ * \param[in]       buff: Ring buffer instance
+ * \param[in]       len: Number of bytes written, must not be greater than reserved length
+ * \return          Number of bytes committed
+ */
+LWRB_API lwrb_sz_t
+lwrb_write_commit(lwrb_t* buff, lwrb_sz_t len) {
+    return lwrb_advance(buff, len);
+}
+
+/*
+ * Needle length, from which lwrb_find uses Boyer-Moore-Horspool search.
+ * Shorter needles are searched by scanning for the first needle byte with `memchr`.
+ */
+#ifndef LWRB_FIND_HORSPOOL_MIN_LEN
+#define LWRB_FIND_HORSPOOL_MIN_LEN 8
+#endif /* LWRB_FIND_HORSPOOL_MIN_LEN */
+
+/**
+ * \brief           Check if needle matches buffer data at specific offset from read pointer.
+ *                  Data may cross the end of the buffer
+ * \param[in]       buff: Ring buffer instance
+ * \param[in]       r_ptr: Read pointer value
+ * \param[in]       offset: Offset from read pointer, where needle is compared
+ * \param[in]       needle: Needle to compare
+ * \param[in]       len: Needle length, offset + len must not be greater than full memory
+ * \return          `1` if data match, `0` otherwise
+ */
+static uint8_t
+prv_match_at(const lwrb_t* buff, lwrb_sz_t r_ptr, lwrb_sz_t offset, const uint8_t* needle, lwrb_sz_t len) {
+    lwrb_sz_t idx = BUF_IDX(buff, BUF_PTR_ADD(buff, r_ptr, offset)), first;
+
+    first = BUF_MIN(BUF_LIN_END(buff) - idx, len);
+    if (memcmp(&buff->buff[idx], needle, first) != 0) {
+        return 0;
+    }
+    return first == len || memcmp(buff->buff, &needle[first], len - first) == 0;
+}
+
 /**
  * \brief           Searches for a *needle* in an array, starting from given offset.
- * 
+ *
+ * Short needles are searched per linear block of the buffer, using `memchr` to find
+ * candidates for the first needle byte (vectorized by most C libraries),
+ * followed by the last byte check and full compare.
+ * Long needles use Boyer-Moore-Horspool search, that skips up to needle length bytes per step.
+ * Candidates close to the end of the buffer are compared across the wrap.
+ *
  * \note            This function is not thread-safe. 
  * 
  * \param           buff: Ring buffer to search for needle in
@@ -653,11 +1850,11 @@ lwrb_advance(lwrb_t* buff, lwrb_sz_t len) {
  *                      Must not be set to `NULL`
  * \return          `1` if \arg bts found, `0` otherwise
  */
-uint8_t
+LWRB_API uint8_t
 lwrb_find(const lwrb_t* buff, const void* bts, lwrb_sz_t len, lwrb_sz_t start_offset, lwrb_sz_t* found_idx) {
-    lwrb_sz_t full = 0, r_ptr = 0, buff_r_ptr = 0, max_x = 0;
-    uint8_t found = 0;
+    lwrb_sz_t full = 0, r_ptr = 0, max_x = 0, skip_x = 0, idx = 0, cnt = 0;
     const uint8_t* needle = bts;
+    const uint8_t* pos;
 
     if (!BUF_IS_VALID(buff) || needle == NULL || len == 0 || found_idx == NULL) {
         return 0;
@@ -671,32 +1868,1191 @@ lwrb_find(const lwrb_t* buff, const void* bts, lwrb_sz_t len, lwrb_sz_t start_of
     }
 
     /* Get actual buffer read pointer for this search */
-    buff_r_ptr = LWRB_LOAD(buff->r_ptr, memory_order_relaxed);
+    r_ptr = LWRB_LOAD(buff->r_ptr, memory_order_relaxed);
 
-    /* Max number of for loops is buff_full - input_len - start_offset of buffer length */
+    /* Last offset, where needle can still start */
     max_x = full - len;
-    for (lwrb_sz_t skip_x = start_offset; !found && skip_x <= max_x; ++skip_x) {
-        found = 1; /* Found by default */
+    skip_x = start_offset;
 
-        /* Prepare the starting point for reading */
-        r_ptr = buff_r_ptr + skip_x;
-        if (r_ptr >= buff->size) {
-            r_ptr -= buff->size;
-        }
+    if (len >= LWRB_FIND_HORSPOOL_MIN_LEN) {
+        uint8_t shift[256];
+        uint8_t last = needle[len - 1];
 
-        /* Search in the buffer */
-        for (lwrb_sz_t idx = 0; idx < len; ++idx) {
-            if (buff->buff[r_ptr] != needle[idx]) {
-                found = 0;
-                break;
-            }
-            if (++r_ptr >= buff->size) {
-                r_ptr = 0;
+        /* Shift table, limited to 255 to keep it small. Shorter shift is always safe */
+        BUF_MEMSET(shift, (int)BUF_MIN(len, 255), sizeof(shift));
+        for (lwrb_sz_t i = 0; i < len - 1; ++i) {
+            shift[needle[i]] = (uint8_t)BUF_MIN(len - 1 - i, 255);
+        }
+        while (skip_x <= max_x) {
+            uint8_t c = buff->buff[BUF_IDX(buff, BUF_PTR_ADD(buff, r_ptr, skip_x + len - 1))];
+            if (c == last && prv_match_at(buff, r_ptr, skip_x, needle, len - 1)) {
+                *found_idx = skip_x;
+                return 1;
             }
+            skip_x += shift[c];
+        }
+        return 0;
+    }
+
+    while (skip_x <= max_x) {
+        /* Number of candidate offsets in current linear block */
+        idx = BUF_IDX(buff, BUF_PTR_ADD(buff, r_ptr, skip_x));
+        cnt = BUF_MIN(max_x - skip_x + 1, BUF_LIN_END(buff) - idx);
+
+        /* Find first byte candidate, then check last byte before full compare */
+        pos = memchr(&buff->buff[idx], needle[0], cnt);
+        if (pos == NULL) {
+            skip_x += cnt;
+            continue;
         }
-        if (found) {
+        skip_x += (lwrb_sz_t)(pos - &buff->buff[idx]);
+        if (len == 1
+            || (buff->buff[BUF_IDX(buff, BUF_PTR_ADD(buff, r_ptr, skip_x + len - 1))] == needle[len - 1]
+                && prv_match_at(buff, r_ptr, skip_x, needle, len - 1))) {
             *found_idx = skip_x;
+            return 1;
+        }
+        ++skip_x;
+    }
+    return 0;
+}
+
+/**
+ * \brief           Read data from buffer up to and including delimiter byte.
+ *
+ * Data is scanned per linear block with `memchr` and copied to output array in the same pass,
+ * then read pointer is advanced once for the complete frame.
+ *
+ * When delimiter is not found in available data, nothing is read and function returns `0`,
+ * as the frame is not complete yet.
+ * When delimiter is not found in first `btr` bytes, `btr` bytes are read
+ * and the last byte in `data` is not the delimiter. This prevents buffer lock with frames longer than `btr`.
+ *
+ * \note            Output `data` array may be modified even if function returns `0`
+ *
+ * \param[in]       buff: Ring buffer instance
+ * \param[in]       delim: Delimiter byte, such as `'\n'` or `'\0'`
+ * \param[out]      data: Pointer to output memory to copy buffer data to
+ * \param[in]       btr: Maximum number of bytes to read, including delimiter
+ * \return          Number of bytes read and copied to data array, including delimiter
+ */
+LWRB_API lwrb_sz_t
+lwrb_read_until(lwrb_t* buff, uint8_t delim, void* data, lwrb_sz_t btr) {
+    lwrb_sz_t full = 0, r_ptr = 0, idx = 0, cnt = 0, copied = 0;
+    uint8_t* d_ptr = data;
+    const uint8_t* pos = NULL;
+
+    if (!BUF_IS_VALID(buff) || data == NULL || btr == 0) {
+        return 0;
+    }
+
+    full = BUF_GET_FULL(buff, btr);
+    if (full == 0) {
+        BUF_STATS_R_REQ(buff, btr, 0);
+        return 0;
+    }
+    r_ptr = LWRB_LOAD(buff->r_ptr, memory_order_acquire);
+
+    /* Scan and copy at most 2 linear blocks, until delimiter is found */
+    while (copied < BUF_MIN(full, btr) && pos == NULL) {
+        idx = BUF_IDX(buff, BUF_PTR_ADD(buff, r_ptr, copied));
+        cnt = BUF_MIN(BUF_MIN(full, btr) - copied, BUF_LIN_END(buff) - idx);
+        pos = memchr(&buff->buff[idx], delim, cnt);
+        if (pos != NULL) {
+            cnt = (lwrb_sz_t)(pos - &buff->buff[idx]) + 1;
+        }
+        BUF_MEMCPY(&d_ptr[copied], &buff->buff[idx], cnt);
+        copied += cnt;
+    }
+
+    /* Frame is not complete yet */
+    if (pos == NULL && copied < btr) {
+        BUF_STATS_R_REQ(buff, btr, 0);
+        return 0;
+    }
+
+    r_ptr = BUF_PTR_ADD(buff, r_ptr, copied);
+    LWRB_STORE(buff->r_ptr, r_ptr, memory_order_release);
+    BUF_SYNC_R_RSV(buff, r_ptr);
+    BUF_SEND_EVT(buff, LWRB_EVT_READ, copied, full - copied);
+    return copied;
+}
+
+/**
+ * \brief           Count number of occurrences of a byte in the buffer.
+ *
+ * Useful to get number of complete delimiter-framed records available,
+ * without copying any data from the buffer.
+ *
+ * \note            This function is not thread-safe when called from producer side
+ *
+ * \param[in]       buff: Ring buffer instance
+ * \param[in]       delim: Byte value to count
+ * \return          Number of `delim` bytes in the buffer
+ */
+LWRB_API lwrb_sz_t
+lwrb_count_byte(const lwrb_t* buff, uint8_t delim) {
+    lwrb_sz_t full = 0, r_ptr = 0, idx = 0, cnt = 0, scanned = 0, num = 0;
+    const uint8_t *pos, *end;
+
+    if (!BUF_IS_VALID(buff)) {
+        return 0;
+    }
+
+    full = lwrb_get_full(buff);
+    r_ptr = LWRB_LOAD(buff->r_ptr, memory_order_relaxed);
+    while (scanned < full) {
+        idx = BUF_IDX(buff, BUF_PTR_ADD(buff, r_ptr, scanned));
+        cnt = BUF_MIN(full - scanned, BUF_LIN_END(buff) - idx);
+        pos = &buff->buff[idx];
+        end = pos + cnt;
+        while (pos < end && (pos = memchr(pos, delim, (size_t)(end - pos))) != NULL) {
+            ++num;
+            ++pos;
         }
+        scanned += cnt;
+    }
+    return num;
+}
+
+/**
+ * \brief           Get payload length of record at specific read pointer position
+ * \param[in]       buff: Ring buffer instance
+ * \param[in]       r_ptr: Read pointer value, where record header starts
+ * \param[in]       full: Number of bytes available from `r_ptr` position
+ * \param[out]      len: Output variable to write payload length to
+ * \return          `1` if complete record is available, `0` otherwise
+ */
+static uint8_t
+prv_msg_len_at(const lwrb_t* buff, lwrb_sz_t r_ptr, lwrb_sz_t full, lwrb_sz_t* len) {
+    if (full < sizeof(*len)) {
+        return 0;
+    }
+    prv_copy_from_buff(buff, r_ptr, (uint8_t*)len, sizeof(*len));
+    return full - sizeof(*len) >= *len;
+}
+
+/**
+ * \brief           Write length-prefixed record to the buffer.
+ *
+ * Length header and payload are written with single write pointer publish,
+ * and only if complete record fits to the buffer, hence read side never sees a partial record.
+ * Each record occupies `sizeof(lwrb_sz_t)` bytes more than its payload.
+ *
+ * \param[in]       buff: Ring buffer instance
+ * \param[in]       data: Record payload
+ * \param[in]       len: Payload length in units of bytes. Must be greater than `0`
+ * \return          `1` if record has been written, `0` otherwise
+ */
+LWRB_API uint8_t
+lwrb_msg_write(lwrb_t* buff, const void* data, lwrb_sz_t len) {
+    lwrb_iovec_t iov[2];
+
+    if (data == NULL || len == 0) {
+        return 0;
+    }
+    iov[0].data = &len;
+    iov[0].len = sizeof(len);
+    iov[1].data = (void*)(uintptr_t)data;
+    iov[1].len = len;
+    return lwrb_writev_ex(buff, iov, 2, NULL, LWRB_FLAG_WRITE_ALL);
+}
+
+/**
+ * \brief           Get payload length of the first record in the buffer, without reading it
+ * \param[in]       buff: Ring buffer instance
+ * \param[out]      len: Output variable to write payload length to
+ * \return          `1` if complete record is available, `0` otherwise
+ */
+LWRB_API uint8_t
+lwrb_msg_peek_len(const lwrb_t* buff, lwrb_sz_t* len) {
+    if (!BUF_IS_VALID(buff) || len == NULL) {
+        return 0;
+    }
+    return prv_msg_len_at(buff, LWRB_LOAD(buff->r_ptr, memory_order_relaxed), lwrb_get_full(buff), len);
+}
+
+/**
+ * \brief           Read first record from the buffer.
+ *
+ * Header is read once and payload is copied directly to the output array.
+ * When payload does not fit to `btr` bytes, record is left in the buffer.
+ * Use \ref lwrb_msg_peek_len to get required array length.
+ *
+ * \param[in]       buff: Ring buffer instance
+ * \param[out]      data: Pointer to output memory to copy record payload to
+ * \param[in]       btr: Size of output memory in units of bytes
+ * \return          Payload length of the record read, `0` if there is no complete record or it does not fit
+ */
+LWRB_API lwrb_sz_t
+lwrb_msg_read(lwrb_t* buff, void* data, lwrb_sz_t btr) {
+    lwrb_sz_t len = 0;
+
+    if (data == NULL || lwrb_msg_read_batch(buff, data, btr, &len, 1) == 0) {
+        return 0;
+    }
+    return len;
+}
+
+/**
+ * \brief           Skip first record in the buffer, without copying it
+ * \param[in]       buff: Ring buffer instance
+ * \return          Payload length of the record skipped, `0` if there is no complete record
+ */
+LWRB_API lwrb_sz_t
+lwrb_msg_skip(lwrb_t* buff) {
+    lwrb_sz_t len = 0;
+
+    if (!lwrb_msg_peek_len(buff, &len)) {
+        return 0;
+    }
+    lwrb_skip(buff, sizeof(len) + len);
+    return len;
+}
+
+/**
+ * \brief           Read up to `max_msgs` records from the buffer, with single read pointer publish.
+ *
+ * Payloads are copied one after another to output array, and payload length
+ * of each record is written to `lens` array.
+ * Reading stops at first record, that does not fit to the remaining output memory.
+ *
+ * \param[in]       buff: Ring buffer instance
+ * \param[out]      data: Pointer to output memory to copy record payloads to
+ * \param[in]       btr: Size of output memory in units of bytes
+ * \param[out]      lens: Array of at least `max_msgs` entries, filled with payload lengths
+ * \param[in]       max_msgs: Maximum number of records to read
+ * \return          Number of records read
+ */
+LWRB_API size_t
+lwrb_msg_read_batch(lwrb_t* buff, void* data, lwrb_sz_t btr, lwrb_sz_t* lens, size_t max_msgs) {
+    lwrb_sz_t full = 0, r_ptr = 0, len = 0, copied = 0, consumed = 0;
+    uint8_t* d_ptr = data;
+    size_t num = 0;
+
+    if (!BUF_IS_VALID(buff) || data == NULL || lens == NULL || max_msgs == 0) {
+        return 0;
+    }
+
+    full = BUF_GET_FULL(buff, btr);
+    r_ptr = LWRB_LOAD(buff->r_ptr, memory_order_acquire);
+
+    /* Parse records from local read pointer copy */
+    while (num < max_msgs && prv_msg_len_at(buff, BUF_PTR_ADD(buff, r_ptr, consumed), full - consumed, &len)
+           && len <= btr - copied) {
+        prv_copy_from_buff(buff, BUF_PTR_ADD(buff, r_ptr, consumed + sizeof(len)), &d_ptr[copied], len);
+        lens[num++] = len;
+        copied += len;
+        consumed += sizeof(len) + len;
+    }
+    if (num == 0) {
+        BUF_STATS_R_REQ(buff, btr, 0);
+        return 0;
+    }
+
+    /* Free all records at once */
+    r_ptr = BUF_PTR_ADD(buff, r_ptr, consumed);
+    LWRB_STORE(buff->r_ptr, r_ptr, memory_order_release);
+    BUF_SYNC_R_RSV(buff, r_ptr);
+    BUF_SEND_EVT(buff, LWRB_EVT_READ, consumed, full - consumed);
+    return num;
+}
+
+#if defined(LWRB_ELEM) || __DOXYGEN__
+
+/**
+ * \brief           Initialize buffer for fixed-size elements.
+ *
+ * Buffer size is whole number of elements, and element functions transfer whole elements only.
+ * Read and write pointers hence always stay at element boundaries
+ * and no element is ever split across the end of buffer memory.
+ * Linear block functions return element aligned addresses and lengths, that are multiple of element size.
+ *
+ * \note            Byte functions may be used on the same buffer, as long as all lengths
+ *                  are multiple of element size
+ * \param[in]       buff: Ring buffer instance
+ * \param[in]       buffdata: Pointer to memory to use as buffer data,
+ *                      of at least \ref LWRB_ELEM_BUFF_SIZE bytes
+ * \param[in]       elem_size: Size of one element in units of bytes
+ * \param[in]       count: Maximum number of elements in the buffer.
+ *                      When `LWRB_POW2` is defined, `elem_size * count` must be power of `2`
+ * \return          `1` on success, `0` otherwise
+ */
+LWRB_API uint8_t
+lwrb_init_elem(lwrb_t* buff, void* buffdata, lwrb_sz_t elem_size, lwrb_sz_t count) {
+    if (elem_size == 0 || count == 0 || count >= (((lwrb_sz_t)-1) / elem_size)
+        || !lwrb_init(buff, buffdata, LWRB_ELEM_BUFF_SIZE(elem_size, count))) {
+        return 0;
+    }
+    buff->elem_size = elem_size;
+    return 1;
+}
+
+/**
+ * \brief           Write whole elements to the buffer, with single write pointer publish
+ * \param[in]       buff: Ring buffer instance
+ * \param[in]       data: Pointer to array of elements
+ * \param[in]       count: Number of elements to write
+ * \return          Number of elements written
+ */
+LWRB_API lwrb_sz_t
+lwrb_write_n(lwrb_t* buff, const void* data, lwrb_sz_t count) {
+    lwrb_sz_t es, bw = 0;
+
+    if (!BUF_IS_VALID(buff) || data == NULL || count == 0) {
+        return 0;
+    }
+    es = buff->elem_size;
+    count = BUF_MIN(count, buff->size / es);
+    count = BUF_MIN(count, BUF_GET_FREE(buff, count * es) / es);
+    lwrb_write_ex(buff, data, count * es, &bw, LWRB_FLAG_WRITE_ALL);
+    return bw / es;
+}
+
+/**
+ * \brief           Read whole elements from the buffer, with single read pointer publish
+ * \param[in]       buff: Ring buffer instance
+ * \param[out]      data: Pointer to array to copy elements to
+ * \param[in]       count: Maximum number of elements to read
+ * \return          Number of elements read
+ */
+LWRB_API lwrb_sz_t
+lwrb_read_n(lwrb_t* buff, void* data, lwrb_sz_t count) {
+    lwrb_sz_t es, br = 0;
+
+    if (!BUF_IS_VALID(buff) || data == NULL || count == 0) {
+        return 0;
+    }
+    es = buff->elem_size;
+    count = BUF_MIN(count, buff->size / es);
+    count = BUF_MIN(count, BUF_GET_FULL(buff, count * es) / es);
+    lwrb_read_ex(buff, data, count * es, &br, LWRB_FLAG_READ_ALL);
+    return br / es;
+}
+
+/**
+ * \brief           Read whole elements without removing them from the buffer
+ * \param[in]       buff: Ring buffer instance
+ * \param[in]       skip_count: Number of elements to skip before reading
+ * \param[out]      data: Pointer to array to copy elements to
+ * \param[in]       count: Maximum number of elements to read
+ * \return          Number of elements read
+ */
+LWRB_API lwrb_sz_t
+lwrb_peek_n(const lwrb_t* buff, lwrb_sz_t skip_count, void* data, lwrb_sz_t count) {
+    lwrb_sz_t es;
+
+    if (!BUF_IS_VALID(buff) || data == NULL || count == 0) {
+        return 0;
+    }
+    es = buff->elem_size;
+    if (skip_count >= buff->size / es) {
+        return 0;
+    }
+    count = BUF_MIN(count, buff->size / es);
+    return lwrb_peek(buff, skip_count * es, data, count * es) / es;
+}
+
+/**
+ * \brief           Get number of elements, that can be written to the buffer
+ * \param[in]       buff: Ring buffer instance
+ * \return          Number of free element slots
+ */
+LWRB_API lwrb_sz_t
+lwrb_get_free_n(const lwrb_t* buff) {
+    if (!BUF_IS_VALID(buff)) {
+        return 0;
+    }
+    return lwrb_get_free(buff) / buff->elem_size;
+}
+
+/**
+ * \brief           Get number of elements in the buffer
+ * \param[in]       buff: Ring buffer instance
+ * \return          Number of elements ready to be read
+ */
+LWRB_API lwrb_sz_t
+lwrb_get_full_n(const lwrb_t* buff) {
+    if (!BUF_IS_VALID(buff)) {
+        return 0;
     }
-    return found;
+    return lwrb_get_full(buff) / buff->elem_size;
 }
+
+#endif /* defined(LWRB_ELEM) || __DOXYGEN__ */
+
+#if defined(LWRB_LOSSY) || __DOXYGEN__
+
+/**
+ * \brief           Initialize buffer for lossy mode.
+ *
+ * In lossy mode, writer never waits and never modifies read side state.
+ * When buffer is full, new data overwrites the oldest data.
+ * Read and write pointers count bytes freely, and serve as sequence numbers:
+ * reader, that falls behind for more than buffer size, detects it from the pointer distance,
+ * resynchronizes to the oldest valid data and reports number of lost bytes.
+ *
+ * Use only \ref lwrb_write_lossy and \ref lwrb_read_lossy on lossy buffer.
+ * Events are not sent in this mode.
+ *
+ * \param[in]       buff: Ring buffer instance
+ * \param[in]       buffdata: Pointer to memory to use as buffer data
+ * \param[in]       size: Size of `buffdata` in units of bytes, must be power of `2`.
+ *                      All bytes are usable
+ * \return          `1` on success, `0` otherwise
+ */
+LWRB_API uint8_t
+lwrb_init_lossy(lwrb_t* buff, void* buffdata, lwrb_sz_t size) {
+    if (size == 0 || (size & (size - 1)) != 0) {
+        return 0;
+    }
+    return lwrb_init(buff, buffdata, size);
+}
+
+/**
+ * \brief           Write data to lossy buffer, overwriting the oldest data when buffer is full.
+ *
+ * Writer announces the end of data it is going to write in `w_head` before it touches the memory,
+ * and publishes the data with write pointer afterwards.
+ * Only single writer is allowed.
+ *
+ * \param[in]       buff: Ring buffer instance
+ * \param[in]       data: Data to write
+ * \param[in]       btw: Bytes To Write. When larger than buffer size, only the last part of data is kept
+ * \return          Value of `btw` on success, `0` otherwise
+ */
+LWRB_API lwrb_sz_t
+lwrb_write_lossy(lwrb_t* buff, const void* data, lwrb_sz_t btw) {
+    const uint8_t* d_ptr = data;
+    lwrb_sz_t w_ptr, end, len = btw;
+
+    if (!BUF_IS_VALID(buff) || data == NULL || btw == 0) {
+        return 0;
+    }
+    w_ptr = LWRB_LOAD(buff->w_ptr, memory_order_relaxed);
+    end = w_ptr + len;
+    if (len > buff->size) {
+        d_ptr += len - buff->size;
+        w_ptr = end - buff->size;
+        len = buff->size;
+    }
+
+    /* Memory is announced as overwritten before it is modified */
+    LWRB_STORE(buff->w_head, end, memory_order_relaxed);
+    atomic_thread_fence(memory_order_release);
+#if defined(LWRB_NT_COPY)
+    if (buff->nt_w_threshold > 0 && len >= buff->nt_w_threshold) {
+        BUF_NT_FENCE(); /* Release fence does not order streaming stores, `w_head` must be visible before them */
+    }
+#endif /* defined(LWRB_NT_COPY) */
+    prv_copy_to_buff(buff, w_ptr & (buff->size - 1), d_ptr, len);
+    LWRB_STORE(buff->w_ptr, end, memory_order_release);
+    return btw;
+}
+
+/**
+ * \brief           Read data from lossy buffer.
+ *
+ * Data is copied first, and validated afterwards against `w_head`.
+ * Bytes, that writer has overwritten in the meantime, are dropped from the output
+ * and reported as lost, same as bytes overwritten before the read started.
+ * Only single reader is allowed.
+ *
+ * \param[in]       buff: Ring buffer instance
+ * \param[out]      data: Pointer to output memory to copy buffer data to
+ * \param[in]       btr: Bytes To Read
+ * \param[out]      lost: Output variable for number of bytes lost since previous read,
+ *                      just before the returned data. Can be set to `NULL`
+ * \return          Number of valid bytes copied to `data`
+ */
+LWRB_API lwrb_sz_t
+lwrb_read_lossy(lwrb_t* buff, void* data, lwrb_sz_t btr, lwrb_sz_t* lost) {
+    uint8_t* d_ptr = data;
+    lwrb_sz_t r_ptr, w_ptr, head, len, skipped = 0;
+
+    if (lost != NULL) {
+        *lost = 0;
+    }
+    if (!BUF_IS_VALID(buff) || data == NULL || btr == 0) {
+        return 0;
+    }
+    r_ptr = LWRB_LOAD(buff->r_ptr, memory_order_relaxed);
+    w_ptr = LWRB_LOAD(buff->w_ptr, memory_order_acquire);
+
+    /* Resynchronize to the oldest data still in the buffer */
+    if (w_ptr - r_ptr > buff->size) {
+        skipped = w_ptr - r_ptr - buff->size;
+        r_ptr = w_ptr - buff->size;
+    }
+    len = BUF_MIN(btr, w_ptr - r_ptr);
+    prv_copy_from_buff(buff, r_ptr & (buff->size - 1), d_ptr, len);
+
+    /* Drop bytes, that writer may have overwritten during the copy */
+    atomic_thread_fence(memory_order_acquire);
+    head = LWRB_LOAD(buff->w_head, memory_order_relaxed);
+    if (head - r_ptr > buff->size) {
+        lwrb_sz_t bad = BUF_MIN(head - r_ptr - buff->size, len);
+
+        memmove(d_ptr, &d_ptr[bad], len - bad);
+        len -= bad;
+        skipped += bad;
+        r_ptr += bad;
+    }
+    LWRB_STORE(buff->r_ptr, r_ptr + len, memory_order_release);
+    if (lost != NULL) {
+        *lost = skipped;
+    }
+    return len;
+}
+
+#endif /* defined(LWRB_LOSSY) || __DOXYGEN__ */
+
+#if defined(LWRB_BCAST) || __DOXYGEN__
+
+#define BCAST_BIT(idx) ((lwrb_sz_t)1 << (idx))
+#define BCAST_IS_VALID(bc)                                                                                             \
+    ((bc) != NULL && BUF_IS_VALID(&(bc)->buff) && (bc)->readers != NULL && (bc)->count > 0)
+
+/**
+ * \brief           Initialize broadcast buffer.
+ *
+ * Writer writes data once with \ref lwrb_bcast_write. Every reader uses its own entry of `readers` array
+ * with regular read functions, such as \ref lwrb_read, \ref lwrb_peek, \ref lwrb_skip
+ * and linear block functions. Free memory for the writer is limited by the slowest active reader.
+ *
+ * \note            Do not call \ref lwrb_reset or write functions on reader handles
+ * \param[in]       bc: Broadcast buffer instance
+ * \param[in]       buffdata: Pointer to memory to use as buffer data
+ * \param[in]       size: Size of `buffdata` in units of bytes, same as for \ref lwrb_init
+ * \param[in]       readers: Array of reader handles, initialized by this function
+ * \param[in]       count: Number of readers, from `1` to \ref LWRB_BCAST_MAX_READERS
+ * \return          `1` on success, `0` otherwise
+ */
+LWRB_API uint8_t
+lwrb_bcast_init(lwrb_bcast_t* bc, void* buffdata, lwrb_sz_t size, lwrb_t* readers, size_t count) {
+    lwrb_sz_t active = 0;
+
+    if (bc == NULL || readers == NULL || count == 0 || count > LWRB_BCAST_MAX_READERS
+        || !lwrb_init(&bc->buff, buffdata, size)) {
+        return 0;
+    }
+    for (size_t i = 0; i < count; ++i) {
+        lwrb_init(&readers[i], buffdata, size);
+        active |= BCAST_BIT(i);
+    }
+    bc->readers = readers;
+    bc->count = count;
+    bc->drop_laggards = 0;
+    LWRB_INIT(bc->active, active);
+    LWRB_INIT(bc->attach_req, 0);
+    return 1;
+}
+
+/**
+ * \brief           Set policy for readers, that do not keep up with the writer.
+ *
+ * By default, writer waits for the slowest reader, as with regular buffer.
+ * When enabled, readers without enough free memory for the write are detached instead,
+ * and writer continues with the remaining ones. Detached reader can check its state
+ * with \ref lwrb_bcast_is_active and attach again with \ref lwrb_bcast_attach.
+ *
+ * \note            Not thread safe, set it during setup
+ * \param[in]       bc: Broadcast buffer instance
+ * \param[in]       drop: Set to `1` to detach laggards, `0` to wait for them
+ */
+LWRB_API void
+lwrb_bcast_set_drop_laggards(lwrb_bcast_t* bc, uint8_t drop) {
+    if (BCAST_IS_VALID(bc)) {
+        bc->drop_laggards = drop;
+    }
+}
+
+/**
+ * \brief           Prepare writer side buffer for write of `btw` bytes.
+ *
+ * Attaches requested readers, detaches laggards if enabled,
+ * and moves writer's read pointer to the slowest active reader
+ * \param[in]       bc: Broadcast buffer instance
+ * \param[in]       btw: Number of bytes to write
+ */
+static void
+prv_bcast_sync(lwrb_bcast_t* bc, lwrb_sz_t btw) {
+    lwrb_sz_t w_ptr, r_min, full_max = 0, req, active, active_new;
+
+    w_ptr = LWRB_LOAD(bc->buff.w_ptr, memory_order_relaxed);
+    active = LWRB_LOAD(bc->active, memory_order_relaxed);
+
+    /* Attached readers start at current write pointer. They wait until active bit is set */
+    req = atomic_exchange_explicit(&bc->attach_req, 0, memory_order_acquire);
+    for (size_t i = 0; i < bc->count; ++i) {
+        if ((req & BCAST_BIT(i)) && !(active & BCAST_BIT(i))) {
+            lwrb_t* rd = &bc->readers[i];
+
+            LWRB_STORE(rd->r_ptr, w_ptr, memory_order_relaxed);
+            LWRB_STORE(rd->w_ptr, w_ptr, memory_order_relaxed);
+#if defined(LWRB_CACHELINE_ISOLATE)
+            rd->w_ptr_cache = w_ptr;
+#endif /* defined(LWRB_CACHELINE_ISOLATE) */
+        }
+    }
+    active |= req;
+
+    /* Find the slowest reader, optionally without laggards */
+    active_new = active;
+    r_min = w_ptr;
+    for (size_t i = 0; i < bc->count; ++i) {
+        lwrb_sz_t r_ptr, full;
+
+        if (!(active & BCAST_BIT(i))) {
+            continue;
+        }
+        r_ptr = LWRB_LOAD(bc->readers[i].r_ptr, memory_order_acquire);
+        if (bc->drop_laggards && prv_calc_free(&bc->buff, w_ptr, r_ptr) < btw) {
+            active_new &= ~BCAST_BIT(i);
+            continue;
+        }
+        full = prv_calc_full(&bc->buff, w_ptr, r_ptr);
+        if (full >= full_max) {
+            full_max = full;
+            r_min = r_ptr;
+        }
+    }
+
+    /* Readers see their state changed before memory gets overwritten */
+    LWRB_STORE(bc->active, active_new, memory_order_release);
+    if (active_new != active) {
+        atomic_thread_fence(memory_order_seq_cst);
+    }
+    LWRB_STORE(bc->buff.r_ptr, r_min, memory_order_relaxed);
+#if defined(LWRB_CACHELINE_ISOLATE)
+    bc->buff.r_ptr_cache = r_min;
+#endif /* defined(LWRB_CACHELINE_ISOLATE) */
+}
+
+/**
+ * \brief           Write data once for all active readers
+ * \param[in]       bc: Broadcast buffer instance
+ * \param[in]       data: Pointer to data to write into buffer
+ * \param[in]       btw: Number of bytes to write
+ * \return          Number of bytes written to buffer
+ */
+LWRB_API lwrb_sz_t
+lwrb_bcast_write(lwrb_bcast_t* bc, const void* data, lwrb_sz_t btw) {
+    lwrb_sz_t written = 0;
+
+    if (lwrb_bcast_write_ex(bc, data, btw, &written, 0)) {
+        return written;
+    }
+    return 0;
+}
+
+/**
+ * \brief           Write data once for all active readers, with extended functionality.
+ *
+ * Each active reader gets \ref LWRB_EVT_WRITE event and its threads,
+ * waiting in \ref lwrb_read_wait, are woken, as after regular write
+ *
+ * \param[in]       bc: Broadcast buffer instance
+ * \param[in]       data: Pointer to data to write into buffer
+ * \param[in]       btw: Number of bytes to write
+ * \param[out]      bwritten: Output pointer to write number of bytes written into the buffer
+ * \param[in]       flags: Optional flags, same as for \ref lwrb_write_ex
+ * \return          `1` if write operation OK, `0` otherwise
+ */
+LWRB_API uint8_t
+lwrb_bcast_write_ex(lwrb_bcast_t* bc, const void* data, lwrb_sz_t btw, lwrb_sz_t* bwritten, uint16_t flags) {
+    lwrb_sz_t w_ptr, active, written = 0;
+    uint8_t res;
+
+    if (!BCAST_IS_VALID(bc) || data == NULL || btw == 0) {
+        return 0;
+    }
+    prv_bcast_sync(bc, btw);
+    res = lwrb_write_ex(&bc->buff, data, btw, &written, flags);
+    if (bwritten != NULL) {
+        *bwritten = written;
+    }
+
+    /* Publish new write pointer to active readers, and notify them as after regular write */
+    w_ptr = LWRB_LOAD(bc->buff.w_ptr, memory_order_relaxed);
+    active = LWRB_LOAD(bc->active, memory_order_relaxed);
+    for (size_t i = 0; i < bc->count; ++i) {
+        if (active & BCAST_BIT(i)) {
+            LWRB_STORE(bc->readers[i].w_ptr, w_ptr, memory_order_release);
+            if (written > 0) {
+                BUF_NOTIFY_EVT(&bc->readers[i], LWRB_EVT_WRITE, written,
+                               prv_calc_full(&bc->readers[i], w_ptr,
+                                             LWRB_LOAD(bc->readers[i].r_ptr, memory_order_relaxed)));
+            }
+        }
+    }
+    return res;
+}
+
+/**
+ * \brief           Get number of bytes, that can be written without waiting for any active reader
+ * \param[in]       bc: Broadcast buffer instance
+ * \return          Number of free bytes in memory
+ */
+LWRB_API lwrb_sz_t
+lwrb_bcast_get_free(const lwrb_bcast_t* bc) {
+    lwrb_sz_t w_ptr, active, free_min;
+
+    if (!BCAST_IS_VALID(bc)) {
+        return 0;
+    }
+    w_ptr = LWRB_LOAD(bc->buff.w_ptr, memory_order_relaxed);
+    active = LWRB_LOAD(bc->active, memory_order_relaxed);
+    free_min = prv_calc_free(&bc->buff, w_ptr, w_ptr);
+    for (size_t i = 0; i < bc->count; ++i) {
+        if (active & BCAST_BIT(i)) {
+            lwrb_sz_t free = prv_calc_free(&bc->buff, w_ptr, LWRB_LOAD(bc->readers[i].r_ptr, memory_order_acquire));
+            free_min = BUF_MIN(free_min, free);
+        }
+    }
+    return free_min;
+}
+
+/**
+ * \brief           Check if reader is attached to the broadcast buffer.
+ *
+ * When laggards are dropped, writer may detach reader and overwrite data, that reader still had to read.
+ * Reader shall call this function after it has read the data and discard the data if reader is not active anymore
+ * \param[in]       bc: Broadcast buffer instance
+ * \param[in]       idx: Reader index
+ * \return          `1` if reader is active, `0` otherwise
+ */
+LWRB_API uint8_t
+lwrb_bcast_is_active(const lwrb_bcast_t* bc, size_t idx) {
+    if (!BCAST_IS_VALID(bc) || idx >= bc->count) {
+        return 0;
+    }
+    /* Order previous reads of buffer memory before state check */
+    atomic_thread_fence(memory_order_seq_cst);
+    return (LWRB_LOAD(bc->active, memory_order_acquire) & BCAST_BIT(idx)) != 0;
+}
+
+/**
+ * \brief           Request detached reader to be attached again.
+ *
+ * Reader is attached by writer, at its next write. Reader then continues with new data only,
+ * and shall not use its handle until \ref lwrb_bcast_is_active returns `1`
+ * \param[in]       bc: Broadcast buffer instance
+ * \param[in]       idx: Reader index
+ * \return          `1` on success, `0` otherwise
+ */
+LWRB_API uint8_t
+lwrb_bcast_attach(lwrb_bcast_t* bc, size_t idx) {
+    if (!BCAST_IS_VALID(bc) || idx >= bc->count) {
+        return 0;
+    }
+    atomic_fetch_or_explicit(&bc->attach_req, BCAST_BIT(idx), memory_order_release);
+    return 1;
+}
+
+#endif /* defined(LWRB_BCAST) || __DOXYGEN__ */
+
+#if defined(LWRB_RESIZE) || __DOXYGEN__
+
+/**
+ * \brief           Move buffer to new memory of different size, keeping its content.
+ *
+ * Data in the buffer, wrapped or not, is copied to the beginning of new memory,
+ * with at most `2` memory copies. Read pointer is then set to `0`, and write pointer
+ * to the number of bytes in the buffer.
+ *
+ * \note            Not thread safe. Neither producer nor consumer may access the buffer during the call
+ * \param[in]       buff: Ring buffer instance
+ * \param[in]       new_data: New buffer data memory, must not overlap with current one
+ * \param[in]       new_size: Size of `new_data` in units of bytes, same rules as for \ref lwrb_init.
+ *                      Must be large enough for data currently in the buffer
+ * \param[out]      old_data: Output variable for previous buffer data memory,
+ *                      that application can release. Can be set to `NULL`
+ * \return          `1` on success, `0` otherwise. Buffer is not modified on failure
+ */
+LWRB_API uint8_t
+lwrb_resize(lwrb_t* buff, void* new_data, lwrb_sz_t new_size, void** old_data) {
+    lwrb_sz_t r_ptr, full;
+
+    if (!BUF_IS_VALID(buff) || new_data == NULL || new_size == 0) {
+        return 0;
+    }
+#if defined(LWRB_POW2)
+    if ((new_size & (new_size - 1)) != 0) {
+        return 0;
+    }
+#endif /* defined(LWRB_POW2) */
+#if defined(LWRB_MIRROR)
+    if (buff->linear_size != buff->size) {
+        return 0; /* Mirrored memory is owned by the library */
+    }
+#endif /* defined(LWRB_MIRROR) */
+#if defined(LWRB_ELEM)
+    if ((new_size % buff->elem_size) != 0) {
+        return 0;
+    }
+#endif /* defined(LWRB_ELEM) */
+
+    r_ptr = LWRB_LOAD(buff->r_ptr, memory_order_relaxed);
+    full = lwrb_get_full(buff);
+#if defined(LWRB_POW2)
+    if (full > new_size) {
+        return 0;
+    }
+#else
+    if (full >= new_size) {
+        return 0;
+    }
+#endif /* defined(LWRB_POW2) */
+    prv_copy_from_buff(buff, r_ptr, new_data, full);
+
+    if (old_data != NULL) {
+        *old_data = buff->buff;
+    }
+    buff->buff = new_data;
+    buff->size = new_size;
+    buff->mem_alloc = 0; /* Memory comes from application */
+#if defined(LWRB_MIRROR)
+    buff->linear_size = new_size;
+#endif /* defined(LWRB_MIRROR) */
+    LWRB_STORE(buff->r_ptr, 0, memory_order_relaxed);
+    LWRB_STORE(buff->w_ptr, full, memory_order_release);
+    BUF_SYNC_W_RSV(buff, full);
+    BUF_SYNC_R_RSV(buff, 0);
+#if defined(LWRB_LOSSY)
+    LWRB_STORE(buff->w_head, full, memory_order_relaxed);
+#endif /* defined(LWRB_LOSSY) */
+#if defined(LWRB_CACHELINE_ISOLATE)
+    buff->r_ptr_cache = 0;
+    buff->w_ptr_cache = full;
+#endif /* defined(LWRB_CACHELINE_ISOLATE) */
+    return 1;
+}
+
+/**
+ * \brief           Initialize buffer with memory allocated by `LWRB_RESIZE_ALLOC` hook, `malloc` by default
+ * \note            Memory must be released with \ref lwrb_free_alloc
+ * \param[in]       buff: Ring buffer instance
+ * \param[in]       size: Size of buffer data in units of bytes, same rules as for \ref lwrb_init
+ * \return          `1` on success, `0` otherwise
+ */
+LWRB_API uint8_t
+lwrb_init_alloc(lwrb_t* buff, lwrb_sz_t size) {
+    void* data;
+
+    if (buff == NULL || size == 0) {
+        return 0;
+    }
+    data = LWRB_RESIZE_ALLOC(size);
+    if (data == NULL) {
+        return 0;
+    }
+    if (!lwrb_init(buff, data, size)) {
+        LWRB_RESIZE_FREE(data);
+        return 0;
+    }
+    buff->mem_alloc = 1;
+    return 1;
+}
+
+/**
+ * \brief           Resize buffer to memory allocated by `LWRB_RESIZE_ALLOC` hook, and release previous memory
+ *                  with `LWRB_RESIZE_FREE` hook
+ * \note            Not thread safe, same as \ref lwrb_resize. Current buffer memory
+ *                  must be allocated by the hook with \ref lwrb_init_alloc or \ref lwrb_resize_alloc,
+ *                  buffers initialized with \ref lwrb_init are rejected
+ * \param[in]       buff: Ring buffer instance
+ * \param[in]       new_size: New size of buffer data in units of bytes
+ * \return          `1` on success, `0` otherwise. Buffer is not modified on failure
+ */
+LWRB_API uint8_t
+lwrb_resize_alloc(lwrb_t* buff, lwrb_sz_t new_size) {
+    void *new_data, *old_data = NULL;
+
+    if (!BUF_IS_VALID(buff) || !buff->mem_alloc || new_size == 0) {
+        return 0;
+    }
+    new_data = LWRB_RESIZE_ALLOC(new_size);
+    if (new_data == NULL) {
+        return 0;
+    }
+    if (!lwrb_resize(buff, new_data, new_size, &old_data)) {
+        LWRB_RESIZE_FREE(new_data);
+        return 0;
+    }
+    LWRB_RESIZE_FREE(old_data);
+    buff->mem_alloc = 1;
+    return 1;
+}
+
+/**
+ * \brief           Release buffer memory allocated by \ref lwrb_init_alloc or \ref lwrb_resize_alloc
+ * \note            Memory provided by application is not released, buffer is only marked as not ready
+ * \param[in]       buff: Ring buffer instance
+ */
+LWRB_API void
+lwrb_free_alloc(lwrb_t* buff) {
+    if (BUF_IS_VALID(buff)) {
+        if (buff->mem_alloc) {
+            LWRB_RESIZE_FREE(buff->buff);
+        }
+        lwrb_free(buff);
+    }
+}
+
+/**
+ * \brief           Adapt buffer size to observed peak number of bytes in the buffer.
+ *
+ * Buffer size is doubled, when peak since previous call reached `3/4` of the capacity,
+ * and halved, when peak stayed below `1/4` of the capacity. Peak is then restarted.
+ * Memory is reallocated with \ref lwrb_resize_alloc, buffer must be initialized with \ref lwrb_init_alloc.
+ *
+ * \note            Not thread safe, same as \ref lwrb_resize.
+ *                  Call it periodically, from a point where buffer is not accessed otherwise
+ * \param[in]       buff: Ring buffer instance
+ * \param[in]       min_size: Minimal buffer size in units of bytes
+ * \param[in]       max_size: Maximal buffer size in units of bytes
+ * \return          Buffer size after the call, `0` on error,
+ *                  when buffer memory is not allocated by the hook or reallocation failed
+ */
+LWRB_API lwrb_sz_t
+lwrb_resize_auto(lwrb_t* buff, lwrb_sz_t min_size, lwrb_sz_t max_size) {
+    lwrb_sz_t size, cap, peak, new_size;
+
+    if (!BUF_IS_VALID(buff) || !buff->mem_alloc) {
+        return 0;
+    }
+    size = buff->size;
+#if defined(LWRB_POW2)
+    cap = size;
+#else
+    cap = size - 1;
+#endif /* defined(LWRB_POW2) */
+    peak = BUF_MAX(buff->peak, lwrb_get_full(buff));
+
+    new_size = size;
+    if (peak >= cap - cap / 4 && size <= max_size / 2) {
+        new_size = size * 2;
+    } else if (peak < cap / 4 && size / 2 >= min_size) {
+        new_size = size / 2;
+    }
+    if (new_size != size && !lwrb_resize_alloc(buff, new_size)) {
+        return 0; /* Buffer is unchanged, peak is kept for next call */
+    }
+    buff->peak = lwrb_get_full(buff);
+    return buff->size;
+}
+
+#endif /* defined(LWRB_RESIZE) || __DOXYGEN__ */
+
+#if defined(LWRB_WAIT) || __DOXYGEN__
+
+/**
+ * \brief           Wait until function returns at least `req` bytes, with spin, yield and park phases
+ * \param[in]       buff: Ring buffer instance
+ * \param[in]       avail_fn: Function returning number of available bytes for waiting side
+ * \param[in]       req: Number of bytes to wait for
+ * \param[in]       seq: Futex word, incremented by the other side
+ * \param[in]       waiters: Number of threads parked on `seq`
+ * \param[in]       timeout_ms: Maximum time to wait in units of milliseconds
+ * \return          `1` if requested bytes are available, `0` on timeout
+ */
+static uint8_t
+prv_wait(const lwrb_t* buff, lwrb_sz_t (*avail_fn)(const lwrb_t*), lwrb_sz_t req, lwrb_atomic_uint_t* seq,
+         lwrb_atomic_uint_t* waiters, uint32_t timeout_ms) {
+    struct timespec deadline, now, rel;
+    uint32_t val;
+    int64_t rem_ns;
+
+    /* Spin, then yield, no system call when other side is fast enough */
+    for (uint32_t i = 0; i < LWRB_WAIT_SPIN_COUNT + LWRB_WAIT_YIELD_COUNT; ++i) {
+        if (avail_fn(buff) >= req) {
+            return 1;
+        }
+        if (timeout_ms == 0) {
+            return 0;
+        }
+        if (i >= LWRB_WAIT_SPIN_COUNT) {
+            sched_yield();
+        }
+    }
+
+    clock_gettime(CLOCK_MONOTONIC, &deadline);
+    if (timeout_ms != LWRB_WAIT_FOREVER) {
+        deadline.tv_sec += timeout_ms / 1000;
+        deadline.tv_nsec += (long)(timeout_ms % 1000) * 1000000L;
+        if (deadline.tv_nsec >= 1000000000L) {
+            deadline.tv_sec += 1;
+            deadline.tv_nsec -= 1000000000L;
+        }
+    }
+
+    /* Park on futex word. Registration is ordered before the check with full fence */
+    while (1) {
+        val = atomic_load_explicit(seq, memory_order_acquire);
+        atomic_fetch_add_explicit(waiters, 1, memory_order_relaxed);
+        atomic_thread_fence(memory_order_seq_cst);
+        if (avail_fn(buff) >= req) {
+            atomic_fetch_sub_explicit(waiters, 1, memory_order_relaxed);
+            return 1;
+        }
+        if (timeout_ms == LWRB_WAIT_FOREVER) {
+            syscall(SYS_futex, seq, FUTEX_WAIT, val, NULL, NULL, 0);
+        } else {
+            clock_gettime(CLOCK_MONOTONIC, &now);
+            /* 64-bit math, `long` overflows for timeouts over ~2 seconds on 32-bit targets */
+            rem_ns = (int64_t)(deadline.tv_sec - now.tv_sec) * 1000000000LL + (deadline.tv_nsec - now.tv_nsec);
+            if (rem_ns <= 0) {
+                atomic_fetch_sub_explicit(waiters, 1, memory_order_relaxed);
+                return avail_fn(buff) >= req;
+            }
+            rel.tv_sec = (time_t)(rem_ns / 1000000000LL);
+            rel.tv_nsec = (long)(rem_ns % 1000000000LL);
+            syscall(SYS_futex, seq, FUTEX_WAIT, val, &rel, NULL, 0);
+        }
+        atomic_fetch_sub_explicit(waiters, 1, memory_order_relaxed);
+    }
+}
+
+/**
+ * \brief           Wait until at least `btr` bytes are available to read.
+ *
+ * Thread first polls the buffer, then yields, and finally sleeps on futex,
+ * until writer publishes new data. Writer makes wake-up system call only when a reader sleeps,
+ * hence read and write functions stay free of system calls otherwise.
+ *
+ * \param[in]       buff: Ring buffer instance
+ * \param[in]       btr: Number of bytes to wait for. Limited to buffer capacity
+ * \param[in]       timeout_ms: Maximum time to wait in units of milliseconds.
+ *                      Use `0` to only check and \ref LWRB_WAIT_FOREVER to wait without limit
+ * \return          `1` if at least `btr` bytes are available, `0` on timeout or invalid input
+ */
+LWRB_API uint8_t
+lwrb_read_wait(lwrb_t* buff, lwrb_sz_t btr, uint32_t timeout_ms) {
+    if (!BUF_IS_VALID(buff)) {
+        return 0;
+    }
+    btr = BUF_MIN(BUF_MAX(btr, 1), prv_calc_free(buff, 0, 0));
+    return prv_wait(buff, lwrb_get_full, btr, &buff->w_seq, &buff->r_wait, timeout_ms);
+}
+
+/**
+ * \brief           Wait until at least `btw` bytes are free for write.
+ *
+ * Thread first polls the buffer, then yields, and finally sleeps on futex,
+ * until reader frees memory. Reader makes wake-up system call only when a writer sleeps.
+ *
+ * \param[in]       buff: Ring buffer instance
+ * \param[in]       btw: Number of bytes to wait for. Limited to buffer capacity
+ * \param[in]       timeout_ms: Maximum time to wait in units of milliseconds.
+ *                      Use `0` to only check and \ref LWRB_WAIT_FOREVER to wait without limit
+ * \return          `1` if at least `btw` bytes are free, `0` on timeout or invalid input
+ */
+LWRB_API uint8_t
+lwrb_write_wait(lwrb_t* buff, lwrb_sz_t btw, uint32_t timeout_ms) {
+    if (!BUF_IS_VALID(buff)) {
+        return 0;
+    }
+    btw = BUF_MIN(BUF_MAX(btw, 1), prv_calc_free(buff, 0, 0));
+    return prv_wait(buff, lwrb_get_free, btw, &buff->r_seq, &buff->w_wait, timeout_ms);
+}
+
+#endif /* defined(LWRB_WAIT) || __DOXYGEN__ */
+
+#if defined(LWRB_STATS) || __DOXYGEN__
+
+/**
+ * \brief           Copy statistics counters of one side, without concurrent update in progress
+ * \param[in]       st: Statistics of one side
+ * \param[out]      out: Output array of `6` entries: bytes, short, failed, edges, peak, dropped
+ */
+static void
+prv_stats_snapshot(const lwrb_stats_side_t* st, lwrb_sz_t* out) {
+    lwrb_sz_t seq;
+
+    while (1) {
+        seq = LWRB_LOAD(st->seq_end, memory_order_acquire);
+        if (LWRB_LOAD(st->seq_begin, memory_order_relaxed) != seq) {
+            continue; /* Update in progress */
+        }
+        out[0] = LWRB_LOAD(st->bytes, memory_order_relaxed);
+        out[1] = LWRB_LOAD(st->short_ops, memory_order_relaxed);
+        out[2] = LWRB_LOAD(st->failed_ops, memory_order_relaxed);
+        out[3] = LWRB_LOAD(st->edges, memory_order_relaxed);
+        out[4] = LWRB_LOAD(st->peak, memory_order_relaxed);
+        out[5] = LWRB_LOAD(st->dropped, memory_order_relaxed);
+        BUF_STATS_FENCE(memory_order_acquire);
+        if (LWRB_LOAD(st->seq_begin, memory_order_relaxed) == seq) {
+            return;
+        }
+    }
+}
+
+/**
+ * \brief           Get snapshot of buffer statistics.
+ *
+ * Counters of each side are copied when no operation of that side is in progress,
+ * hence they are consistent with each other. Write and read side are copied one after another.
+ * Function may be called from any thread, for example from monitoring task.
+ *
+ * \note            Function waits for operation in progress to finish. It must not be called
+ *                      from interrupt, that may preempt buffer read or write operation
+ *
+ * \param[in]       buff: Ring buffer instance
+ * \param[out]      stats: Output variable to write statistics to
+ * \return          `1` on success, `0` otherwise
+ */
+LWRB_API uint8_t
+lwrb_get_stats(const lwrb_t* buff, lwrb_stats_t* stats) {
+    lwrb_sz_t w[6], r[6];
+
+    if (!BUF_IS_VALID(buff) || stats == NULL) {
+        return 0;
+    }
+    prv_stats_snapshot(&buff->w_stats, w);
+    prv_stats_snapshot(&buff->r_stats, r);
+
+    stats->bytes_in = w[0];
+    stats->write_short = w[1];
+    stats->write_failed = w[2];
+    stats->full_count = w[3];
+    stats->peak_full = w[4];
+    stats->overwritten = w[5];
+    stats->bytes_out = r[0];
+    stats->read_short = r[1];
+    stats->read_failed = r[2];
+    stats->empty_count = r[3];
+    return 1;
+}
+
+#endif /* defined(LWRB_STATS) || __DOXYGEN__ */
+
+#if defined(LWRB_NT_COPY) || __DOXYGEN__
+
+/**
+ * \brief           Set length thresholds for non-temporal copy of large transfers.
+ *
+ * Write of at least `write_threshold` bytes copies data to buffer memory with streaming stores,
+ * that bypass the cache and do not evict working set of the consumer.
+ * Read of at least `read_threshold` bytes prefetches buffer memory with non-temporal hint.
+ * Thresholds apply to single call of functions, that copy data to or from buffer memory.
+ *
+ * \note            Set thresholds only when buffer is not being accessed, typically right after initialization
+ * \param[in]       buff: Ring buffer instance
+ * \param[in]       write_threshold: Minimal write length in units of bytes, `0` to always use regular copy
+ * \param[in]       read_threshold: Minimal read length in units of bytes, `0` to always use regular copy
+ * \return          `1` on success, `0` otherwise
+ */
+LWRB_API uint8_t
+lwrb_set_nt_threshold(lwrb_t* buff, lwrb_sz_t write_threshold, lwrb_sz_t read_threshold) {
+    if (!BUF_IS_VALID(buff)) {
+        return 0;
+    }
+    buff->nt_w_threshold = write_threshold;
+    buff->nt_r_threshold = read_threshold;
+    return 1;
+}
+
+#endif /* defined(LWRB_NT_COPY) || __DOXYGEN__ */
+
+#endif /* LWRB_SRC_C */
@@ -32,14 +32,12 @@
  * Version:         v3.3.0
  */
 #include "lwrb/lwrb.h"
+#include "lwrb_priv.h"
 
 #if defined(LWRB_DEV)
 
 /* Do not build if development mode isn't enabled */
 
-#define BUF_IS_VALID(b) ((b) != NULL && (b)->buff != NULL && (b)->size > 0)
-#define BUF_MIN(x, y)   ((x) < (y) ? (x) : (y))
-
 /**
  * \brief           Writes data to buffer with overwrite function, if no enough space to hold
  *                  complete input data object.
@@ -52,6 +50,7 @@
  *                      writes the wrap region if there is more data to write. The r indicator is advanced if w overtakes
  *                      it. This operation is a read op as well as a write op. For thread-safety mutexes may be desired,
  *                      see documentation.
+ * \note            For writer, that must not block concurrent reader, use \ref lwrb_write_lossy instead
  */
 lwrb_sz_t
 lwrb_overwrite(lwrb_t* buff, const void* data, lwrb_sz_t btw) {
@@ -63,7 +62,11 @@ lwrb_overwrite(lwrb_t* buff, const void* data, lwrb_sz_t btw) {
     }
 
     /* Process complete input array */
+#if defined(LWRB_POW2)
+    max_cap = buff->size; /* Power of 2 buffer can use its full size */
+#else
     max_cap = buff->size - 1; /* Maximum capacity buffer can hold */
+#endif /* defined(LWRB_POW2) */
     if (btw > max_cap) {
         /*
          * When data to write is larger than max buffer capacity,
@@ -73,6 +76,10 @@ lwrb_overwrite(lwrb_t* buff, const void* data, lwrb_sz_t btw) {
          * This is done here, by calculating remaining
          * length and then advancing to the end of input buffer
          */
+#if defined(LWRB_STATS)
+        /* Buffer content and leading part of input are dropped */
+        lwrb_priv_drop(buff, 0, lwrb_get_full(buff) + btw - max_cap);
+#endif /* defined(LWRB_STATS) */
         d += btw - max_cap; /* Advance data */
         btw = max_cap;      /* Limit data to write */
         lwrb_reset(buff);   /* Reset buffer */
@@ -86,7 +93,11 @@ lwrb_overwrite(lwrb_t* buff, const void* data, lwrb_sz_t btw) {
          */
         lwrb_sz_t f = lwrb_get_free(buff);
         if (f < btw) {
+#if defined(LWRB_STATS)
+            lwrb_priv_drop(buff, btw - f, 0); /* Removed bytes are dropped, not read */
+#else
             lwrb_skip(buff, btw - f);
+#endif /* defined(LWRB_STATS) */
         }
     }
     lwrb_write(buff, d, btw);
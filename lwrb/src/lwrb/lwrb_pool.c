@@ -0,0 +1,181 @@
+/**
+ * \file            lwrb_pool.c
+ * \brief           Lightweight ring buffer - pool of buffers in preallocated arenas
+ */
+
+/*
+ * Copyright (c) 2024 Tilen MAJERLE
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the "Software"), to deal in the Software without restriction,
+ * including without limitation the rights to use, copy, modify, merge,
+ * publish, distribute, sublicense, and/or sell copies of the Software,
+ * and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE
+ * AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * This file is part of LwRB - Lightweight ring buffer library.
+ *
+ * Author:          Tilen MAJERLE <tilen@majerle.eu>
+ * Version:         v3.3.0
+ */
+#include "lwrb/lwrb.h"
+#include "lwrb_priv.h"
+
+#if defined(LWRB_POOL)
+
+/* Slot alignment, never less than alignment of buffer handle, which is over-aligned with cache line isolation */
+#define POOL_ALIGN       BUF_MAX((size_t)LWRB_POOL_ALIGN, _Alignof(lwrb_t))
+#define POOL_ALIGN_UP(x) (((x) + (POOL_ALIGN - 1)) & ~(size_t)(POOL_ALIGN - 1))
+
+/* Released slot, linked over the memory of its buffer handle */
+typedef struct pool_free_slot {
+    struct pool_free_slot* next;
+} pool_free_slot_t;
+
+/**
+ * \brief           Initialize buffer pool.
+ *
+ * Buffers are allocated from the arena by increasing address, buffer handle immediately followed by its data,
+ * and get recycled through per-class free lists. Allocation and release are both `O(1)`.
+ *
+ * \note            Pool is not thread safe
+ * \param[out]      pool: Pool instance
+ * \param[in]       arena: Memory to allocate buffers from
+ * \param[in]       arena_size: Size of `arena` in units of bytes
+ * \param[in]       sizes: Array of buffer data sizes, as passed to \ref lwrb_init, in ascending order
+ * \param[in]       count: Number of entries in `sizes`, up to \ref LWRB_POOL_MAX_CLASSES
+ * \return          `1` on success, `0` otherwise
+ */
+uint8_t
+lwrb_pool_init(lwrb_pool_t* pool, void* arena, size_t arena_size, const lwrb_sz_t* sizes, size_t count) {
+    if (pool == NULL || sizes == NULL || count == 0 || count > LWRB_POOL_MAX_CLASSES) {
+        return 0;
+    }
+    for (size_t i = 0; i < count; ++i) {
+        if (sizes[i] == 0 || (i > 0 && sizes[i] <= sizes[i - 1])) {
+            return 0;
+        }
+#if defined(LWRB_POW2)
+        if ((sizes[i] & (sizes[i] - 1)) != 0) {
+            return 0;
+        }
+#endif /* defined(LWRB_POW2) */
+    }
+    memset(pool, 0x00, sizeof(*pool));
+    for (size_t i = 0; i < count; ++i) {
+        pool->classes[i].size = sizes[i];
+        pool->classes[i].slot_size = POOL_ALIGN_UP(sizeof(lwrb_t) + (size_t)sizes[i]);
+    }
+    pool->class_count = count;
+    return lwrb_pool_add_arena(pool, arena, arena_size);
+}
+
+/**
+ * \brief           Set new arena to allocate buffers from, when current one is exhausted.
+ *
+ * Released buffers of previous arenas are still recycled,
+ * but unused remainder of current arena is abandoned
+ * \param[in]       pool: Pool instance
+ * \param[in]       arena: Memory to allocate buffers from. Must stay valid during pool lifetime
+ * \param[in]       arena_size: Size of `arena` in units of bytes
+ * \return          `1` on success, `0` otherwise
+ */
+uint8_t
+lwrb_pool_add_arena(lwrb_pool_t* pool, void* arena, size_t arena_size) {
+    uintptr_t start, end;
+
+    if (pool == NULL || arena == NULL || arena_size == 0) {
+        return 0;
+    }
+    start = POOL_ALIGN_UP((uintptr_t)arena);
+    end = (uintptr_t)arena + arena_size;
+    if (start >= end) {
+        return 0;
+    }
+    pool->arena_pos = (uint8_t*)start;
+    pool->arena_end = (uint8_t*)end;
+    return 1;
+}
+
+/**
+ * \brief           Allocate initialized buffer from the pool
+ * \param[in]       pool: Pool instance
+ * \param[in]       size: Minimal buffer data size, as passed to \ref lwrb_init.
+ *                      Buffer of the smallest fitting size class is returned
+ * \return          Buffer handle on success, `NULL` if there is no fitting class or memory is exhausted
+ */
+lwrb_t*
+lwrb_pool_alloc(lwrb_pool_t* pool, lwrb_sz_t size) {
+    lwrb_pool_class_t* cls = NULL;
+    uint8_t* slot;
+
+    if (pool == NULL) {
+        return NULL;
+    }
+    for (size_t i = 0; i < pool->class_count; ++i) {
+        if (pool->classes[i].size >= size) {
+            cls = &pool->classes[i];
+            break;
+        }
+    }
+    if (cls == NULL) {
+        return NULL;
+    }
+
+    if (cls->free_list != NULL) {
+        slot = cls->free_list;
+        cls->free_list = ((pool_free_slot_t*)cls->free_list)->next;
+    } else if ((size_t)(pool->arena_end - pool->arena_pos) >= cls->slot_size) {
+        slot = pool->arena_pos;
+        pool->arena_pos += cls->slot_size;
+    } else {
+        return NULL;
+    }
+    ++cls->used;
+    lwrb_init((lwrb_t*)slot, slot + sizeof(lwrb_t), cls->size);
+    return (lwrb_t*)slot;
+}
+
+/**
+ * \brief           Release buffer back to the pool
+ * \param[in]       pool: Pool instance
+ * \param[in]       buff: Buffer handle, allocated with \ref lwrb_pool_alloc from the same pool
+ * \return          `1` on success, `0` otherwise
+ */
+uint8_t
+lwrb_pool_free(lwrb_pool_t* pool, lwrb_t* buff) {
+    lwrb_pool_class_t* cls = NULL;
+
+    if (pool == NULL || buff == NULL || buff->buff != (uint8_t*)buff + sizeof(lwrb_t)) {
+        return 0;
+    }
+    for (size_t i = 0; i < pool->class_count; ++i) {
+        if (pool->classes[i].size == buff->size) {
+            cls = &pool->classes[i];
+            break;
+        }
+    }
+    if (cls == NULL || cls->used == 0) {
+        return 0;
+    }
+    lwrb_free(buff);
+    ((pool_free_slot_t*)(void*)buff)->next = cls->free_list;
+    cls->free_list = buff;
+    --cls->used;
+    return 1;
+}
+
+#endif /* defined(LWRB_POOL) */
@@ -0,0 +1,514 @@
+/**
+ * \file            lwrb_seg.c
+ * \brief           Lightweight ring buffer - segmented buffer with shared chunk pool
+ */
+
+/*
+ * Copyright (c) 2024 Tilen MAJERLE
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the "Software"), to deal in the Software without restriction,
+ * including without limitation the rights to use, copy, modify, merge,
+ * publish, distribute, sublicense, and/or sell copies of the Software,
+ * and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE
+ * AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * This file is part of LwRB - Lightweight ring buffer library.
+ *
+ * Author:          Tilen MAJERLE <tilen@majerle.eu>
+ * Version:         v3.3.0
+ */
+#include "lwrb/lwrb.h"
+#include "lwrb_priv.h"
+
+#if defined(LWRB_SEG)
+
+#define SEG_DATA(c)      ((uint8_t*)(c) + sizeof(lwrb_seg_chunk_t))
+#define SEG_VALID(b)     ((b) != NULL && (b)->pool != NULL)
+#define SEG_TAIL_FREE(b) ((b)->tail != NULL ? (b)->pool->chunk_size - (b)->w_off : 0)
+
+/*
+ * Chunks are always filled completely, before next chunk is appended.
+ * Chunk, that starts at byte count `s`, holds bytes `s` to `s + chunk_size - 1`.
+ *
+ * Producer returns chunk to the pool only when read count went past its end,
+ * so consumer has already moved its `head` to the next chunk and never touches returned chunk.
+ * As a consequence, buffer keeps its last chunk when it is empty.
+ */
+
+/**
+ * \brief           Get number of bytes in the buffer
+ * \param[in]       buff: Segmented buffer
+ * \return          Number of bytes
+ */
+static inline lwrb_sz_t
+prv_get_full(const lwrb_seg_t* buff) {
+    lwrb_sz_t w_cnt, r_cnt;
+
+    /* Read count first, it can never pass write count loaded afterwards */
+    r_cnt = LWRB_LOAD(buff->r_cnt, memory_order_acquire);
+    w_cnt = LWRB_LOAD(buff->w_cnt, memory_order_acquire);
+    return w_cnt - r_cnt;
+}
+
+/**
+ * \brief           Get number of bytes, producer may still add to the buffer according to `max_size`
+ * \param[in]       buff: Segmented buffer
+ * \return          Number of bytes
+ */
+static inline lwrb_sz_t
+prv_get_room(const lwrb_seg_t* buff) {
+    lwrb_sz_t full;
+
+    if (buff->max_size == 0) {
+        return (lwrb_sz_t)-1;
+    }
+    full = prv_get_full(buff);
+    return buff->max_size - BUF_MIN(full, buff->max_size);
+}
+
+/**
+ * \brief           Return consumed chunks to the pool, called by producer
+ * \param[in]       buff: Segmented buffer
+ */
+static void
+prv_reclaim(lwrb_seg_t* buff) {
+    lwrb_seg_pool_t* pool = buff->pool;
+    lwrb_sz_t r_cnt = LWRB_LOAD(buff->r_cnt, memory_order_acquire);
+
+    while (buff->rel != buff->tail && (lwrb_sz_t)(r_cnt - buff->rel_start) > pool->chunk_size) {
+        lwrb_seg_chunk_t* chunk = buff->rel;
+
+        buff->rel = chunk->next;
+        buff->rel_start += pool->chunk_size;
+        chunk->next = pool->free_list;
+        pool->free_list = chunk;
+        ++pool->free;
+    }
+}
+
+/**
+ * \brief           Make sure tail chunk has free space, take new chunk from the pool if not
+ * \param[in]       buff: Segmented buffer
+ * \return          `1` when tail chunk has free space, `0` otherwise
+ */
+static uint8_t
+prv_reserve_tail(lwrb_seg_t* buff) {
+    lwrb_seg_pool_t* pool = buff->pool;
+    lwrb_seg_chunk_t* chunk;
+
+    if (SEG_TAIL_FREE(buff) > 0) {
+        return 1;
+    }
+    prv_reclaim(buff);
+    chunk = pool->free_list;
+    if (chunk == NULL) {
+        return 0;
+    }
+    pool->free_list = chunk->next;
+    --pool->free;
+    chunk->next = NULL;
+    if (buff->tail == NULL) {
+        /* First chunk. Consumer does not access its part, until it sees written data */
+        buff->head = chunk;
+        buff->r_off = 0;
+        buff->rel = chunk;
+        buff->rel_start = LWRB_LOAD(buff->w_cnt, memory_order_relaxed);
+    } else {
+        buff->tail->next = chunk; /* Published to consumer with next `w_cnt` update */
+    }
+    buff->tail = chunk;
+    buff->w_off = 0;
+    return 1;
+}
+
+/**
+ * \brief           Get position of the first byte to read, called by consumer when buffer is not empty
+ * \param[in]       buff: Segmented buffer
+ * \param[out]      off: Offset of the byte in returned chunk
+ * \return          Chunk holding the byte
+ */
+static inline lwrb_seg_chunk_t*
+prv_read_pos(const lwrb_seg_t* buff, lwrb_sz_t* off) {
+    if (buff->r_off == buff->pool->chunk_size) {
+        *off = 0;
+        return buff->head->next;
+    }
+    *off = buff->r_off;
+    return buff->head;
+}
+
+/**
+ * \brief           Remove data from the buffer, optionally copy it to application memory
+ * \param[in]       buff: Segmented buffer
+ * \param[out]      data: Memory to copy data to, `NULL` to drop data
+ * \param[in]       len: Number of bytes to remove, must not exceed number of bytes in the buffer
+ * \return          Number of removed bytes
+ */
+static lwrb_sz_t
+prv_consume(lwrb_seg_t* buff, uint8_t* data, lwrb_sz_t len) {
+    lwrb_sz_t done = 0, chunk_size = buff->pool->chunk_size;
+
+    while (done < len) {
+        lwrb_sz_t tocopy;
+
+        if (buff->r_off == chunk_size) {
+            buff->head = buff->head->next;
+            buff->r_off = 0;
+        }
+        tocopy = BUF_MIN(chunk_size - buff->r_off, len - done);
+        if (data != NULL) {
+            memcpy(&data[done], SEG_DATA(buff->head) + buff->r_off, tocopy);
+        }
+        buff->r_off += tocopy;
+        done += tocopy;
+    }
+    LWRB_STORE(buff->r_cnt, LWRB_LOAD(buff->r_cnt, memory_order_relaxed) + done, memory_order_release);
+    return done;
+}
+
+/**
+ * \brief           Initialize pool of chunks.
+ *
+ * Pool memory is global budget of all segmented buffers, that use the pool
+ * \note            Pool is accessed by write side functions of its buffers,
+ *                  that must run in one thread or under one lock
+ * \param[out]      pool: Pool instance
+ * \param[in]       mem: Memory to split into chunks. Must stay valid during pool lifetime
+ * \param[in]       mem_size: Size of `mem` in units of bytes
+ * \param[in]       chunk_size: Data size of one chunk in units of bytes.
+ *                      Linear blocks of segmented buffers are at most this long
+ * \return          `1` on success, `0` otherwise
+ */
+uint8_t
+lwrb_seg_pool_init(lwrb_seg_pool_t* pool, void* mem, size_t mem_size, lwrb_sz_t chunk_size) {
+    uintptr_t pos, end;
+
+    if (pool == NULL || mem == NULL || chunk_size == 0) {
+        return 0;
+    }
+    memset(pool, 0x00, sizeof(*pool));
+    pool->chunk_size = chunk_size;
+    pool->slot_size = (sizeof(lwrb_seg_chunk_t) + (size_t)chunk_size + sizeof(void*) - 1) & ~(sizeof(void*) - 1);
+
+    /* Link all chunks to the free list, in address order */
+    pos = ((uintptr_t)mem + sizeof(void*) - 1) & ~(uintptr_t)(sizeof(void*) - 1);
+    end = (uintptr_t)mem + mem_size;
+    for (lwrb_seg_chunk_t** next = &pool->free_list; pos < end && end - pos >= pool->slot_size;
+         pos += pool->slot_size) {
+        *next = (lwrb_seg_chunk_t*)pos;
+        next = &(*next)->next;
+        *next = NULL;
+        ++pool->total;
+    }
+    pool->free = pool->total;
+    return pool->total > 0;
+}
+
+/**
+ * \brief           Get number of unused chunks in the pool
+ * \param[in]       pool: Pool instance
+ * \return          Number of unused chunks
+ */
+size_t
+lwrb_seg_pool_get_free(const lwrb_seg_pool_t* pool) {
+    return pool != NULL ? pool->free : 0;
+}
+
+/**
+ * \brief           Initialize empty segmented buffer.
+ *
+ * Buffer holds no memory until data is written to it
+ * \param[out]      buff: Segmented buffer
+ * \param[in]       pool: Pool to take chunks from
+ * \param[in]       max_size: Maximal number of bytes in the buffer, `0` to be limited by the pool only
+ * \return          `1` on success, `0` otherwise
+ */
+uint8_t
+lwrb_seg_init(lwrb_seg_t* buff, lwrb_seg_pool_t* pool, lwrb_sz_t max_size) {
+    if (buff == NULL || pool == NULL) {
+        return 0;
+    }
+    memset((void*)buff, 0x00, sizeof(*buff));
+    buff->pool = pool;
+    buff->max_size = max_size;
+    LWRB_INIT(buff->w_cnt, 0);
+    LWRB_INIT(buff->r_cnt, 0);
+    return 1;
+}
+
+/**
+ * \brief           Drop all data and return all chunks to the pool
+ * \note            Not thread safe. Neither producer nor consumer may access the buffer during the call
+ * \param[in]       buff: Segmented buffer
+ */
+void
+lwrb_seg_reset(lwrb_seg_t* buff) {
+    lwrb_seg_pool_t* pool;
+
+    if (!SEG_VALID(buff)) {
+        return;
+    }
+    pool = buff->pool;
+    while (buff->rel != NULL) {
+        lwrb_seg_chunk_t* chunk = buff->rel;
+
+        buff->rel = chunk->next;
+        chunk->next = pool->free_list;
+        pool->free_list = chunk;
+        ++pool->free;
+    }
+    buff->head = buff->tail = NULL;
+    buff->r_off = buff->w_off = 0;
+    buff->rel_start = 0;
+    LWRB_STORE(buff->w_cnt, 0, memory_order_relaxed);
+    LWRB_STORE(buff->r_cnt, 0, memory_order_relaxed);
+}
+
+/**
+ * \brief           Get number of bytes, that can currently be written to the buffer.
+ *
+ * Value depends on unused chunks of the shared pool and can decrease when other buffers write.
+ * Chunks consumed by reader are included, they are returned to the pool at next write
+ * \param[in]       buff: Segmented buffer
+ * \return          Number of free bytes
+ */
+lwrb_sz_t
+lwrb_seg_get_free(const lwrb_seg_t* buff) {
+    size_t avail;
+    lwrb_sz_t r_cnt, chunk_size;
+
+    if (!SEG_VALID(buff)) {
+        return 0;
+    }
+    chunk_size = buff->pool->chunk_size;
+    r_cnt = LWRB_LOAD(buff->r_cnt, memory_order_acquire);
+    avail = buff->pool->free * (size_t)chunk_size + SEG_TAIL_FREE(buff);
+    if (buff->rel != buff->tail && (lwrb_sz_t)(r_cnt - buff->rel_start) > chunk_size) {
+        avail += (size_t)((r_cnt - buff->rel_start - 1) / chunk_size) * chunk_size;
+    }
+    return (lwrb_sz_t)BUF_MIN(avail, (size_t)prv_get_room(buff));
+}
+
+/**
+ * \brief           Get number of bytes in the buffer
+ * \param[in]       buff: Segmented buffer
+ * \return          Number of bytes ready to be read
+ */
+lwrb_sz_t
+lwrb_seg_get_full(const lwrb_seg_t* buff) {
+    return SEG_VALID(buff) ? prv_get_full(buff) : 0;
+}
+
+/**
+ * \brief           Write data to the buffer, taking chunks from the pool as needed
+ * \param[in]       buff: Segmented buffer
+ * \param[in]       data: Data to write
+ * \param[in]       btw: Number of bytes to write
+ * \return          Number of bytes written, less than `btw` when buffer or pool limit is reached
+ */
+lwrb_sz_t
+lwrb_seg_write(lwrb_seg_t* buff, const void* data, lwrb_sz_t btw) {
+    const uint8_t* d = data;
+    lwrb_sz_t done = 0;
+
+    if (!SEG_VALID(buff) || data == NULL) {
+        return 0;
+    }
+    btw = BUF_MIN(btw, prv_get_room(buff));
+    while (done < btw && prv_reserve_tail(buff)) {
+        lwrb_sz_t tocopy = BUF_MIN(SEG_TAIL_FREE(buff), btw - done);
+
+        memcpy(SEG_DATA(buff->tail) + buff->w_off, &d[done], tocopy);
+        buff->w_off += tocopy;
+        done += tocopy;
+    }
+    LWRB_STORE(buff->w_cnt, LWRB_LOAD(buff->w_cnt, memory_order_relaxed) + done, memory_order_release);
+    return done;
+}
+
+/**
+ * \brief           Read data from the buffer
+ * \param[in]       buff: Segmented buffer
+ * \param[out]      data: Memory to copy data to
+ * \param[in]       btr: Maximal number of bytes to read
+ * \return          Number of bytes read
+ */
+lwrb_sz_t
+lwrb_seg_read(lwrb_seg_t* buff, void* data, lwrb_sz_t btr) {
+    if (!SEG_VALID(buff) || data == NULL) {
+        return 0;
+    }
+    return prv_consume(buff, data, BUF_MIN(btr, prv_get_full(buff)));
+}
+
+/**
+ * \brief           Copy data from the buffer without removing it
+ * \param[in]       buff: Segmented buffer
+ * \param[in]       skip_count: Number of bytes to skip before copying
+ * \param[out]      data: Memory to copy data to
+ * \param[in]       btp: Maximal number of bytes to copy
+ * \return          Number of bytes copied
+ */
+lwrb_sz_t
+lwrb_seg_peek(const lwrb_seg_t* buff, lwrb_sz_t skip_count, void* data, lwrb_sz_t btp) {
+    const lwrb_seg_chunk_t* chunk;
+    uint8_t* d = data;
+    lwrb_sz_t full, off, done = 0;
+
+    if (!SEG_VALID(buff) || data == NULL) {
+        return 0;
+    }
+    full = prv_get_full(buff);
+    if (skip_count >= full) {
+        return 0;
+    }
+    btp = BUF_MIN(btp, full - skip_count);
+
+    /* Only the head chunk is partially consumed, all others start at offset 0 */
+    chunk = prv_read_pos(buff, &off);
+    off += skip_count;
+    while (off >= buff->pool->chunk_size) {
+        off -= buff->pool->chunk_size;
+        chunk = chunk->next;
+    }
+    while (done < btp) {
+        lwrb_sz_t tocopy = BUF_MIN(buff->pool->chunk_size - off, btp - done);
+
+        memcpy(&d[done], SEG_DATA(chunk) + off, tocopy);
+        done += tocopy;
+        off = 0;
+        chunk = chunk->next;
+    }
+    return done;
+}
+
+/**
+ * \brief           Remove data from the buffer without copying it
+ * \param[in]       buff: Segmented buffer
+ * \param[in]       len: Maximal number of bytes to remove
+ * \return          Number of bytes removed
+ */
+lwrb_sz_t
+lwrb_seg_skip(lwrb_seg_t* buff, lwrb_sz_t len) {
+    if (!SEG_VALID(buff)) {
+        return 0;
+    }
+    return prv_consume(buff, NULL, BUF_MIN(len, prv_get_full(buff)));
+}
+
+/**
+ * \brief           Take new chunk from the pool for linear block write, when tail chunk has no free space.
+ *
+ * Call it before linear block write address is queried, such as before DMA transfer is started.
+ * Consumed chunks are returned to the pool first
+ * \param[in]       buff: Segmented buffer
+ * \return          Linear block write length after the call
+ */
+lwrb_sz_t
+lwrb_seg_reserve(lwrb_seg_t* buff) {
+    if (!SEG_VALID(buff) || prv_get_room(buff) == 0) {
+        return 0;
+    }
+    prv_reserve_tail(buff);
+    return lwrb_seg_get_linear_block_write_length(buff);
+}
+
+/**
+ * \brief           Mark data, written with linear block write address, as written
+ * \param[in]       buff: Segmented buffer
+ * \param[in]       len: Number of bytes written, at most linear block write length
+ * \return          Number of bytes marked as written
+ */
+lwrb_sz_t
+lwrb_seg_advance(lwrb_seg_t* buff, lwrb_sz_t len) {
+    if (!SEG_VALID(buff)) {
+        return 0;
+    }
+    len = BUF_MIN(len, lwrb_seg_get_linear_block_write_length(buff));
+    buff->w_off += len;
+    LWRB_STORE(buff->w_cnt, LWRB_LOAD(buff->w_cnt, memory_order_relaxed) + len, memory_order_release);
+    return len;
+}
+
+/**
+ * \brief           Get address of the first byte to read.
+ *
+ * Linear block never crosses chunk boundary
+ * \param[in]       buff: Segmented buffer
+ * \return          Read address, `NULL` when buffer is empty
+ */
+void*
+lwrb_seg_get_linear_block_read_address(const lwrb_seg_t* buff) {
+    lwrb_seg_chunk_t* chunk;
+    lwrb_sz_t off;
+
+    if (!SEG_VALID(buff) || prv_get_full(buff) == 0) {
+        return NULL;
+    }
+    chunk = prv_read_pos(buff, &off);
+    return SEG_DATA(chunk) + off;
+}
+
+/**
+ * \brief           Get length of linear block at read address, limited by the end of the chunk
+ * \param[in]       buff: Segmented buffer
+ * \return          Linear read length
+ */
+lwrb_sz_t
+lwrb_seg_get_linear_block_read_length(const lwrb_seg_t* buff) {
+    lwrb_sz_t full, off;
+
+    if (!SEG_VALID(buff)) {
+        return 0;
+    }
+    full = prv_get_full(buff);
+    if (full == 0) {
+        return 0;
+    }
+    prv_read_pos(buff, &off);
+    return BUF_MIN(buff->pool->chunk_size - off, full);
+}
+
+/**
+ * \brief           Get address to write next data to, in the tail chunk.
+ *
+ * Function does not take chunks from the pool, see \ref lwrb_seg_reserve
+ * \param[in]       buff: Segmented buffer
+ * \return          Write address, `NULL` when tail chunk has no free space or buffer limit is reached
+ */
+void*
+lwrb_seg_get_linear_block_write_address(const lwrb_seg_t* buff) {
+    if (lwrb_seg_get_linear_block_write_length(buff) == 0) {
+        return NULL;
+    }
+    return SEG_DATA(buff->tail) + buff->w_off;
+}
+
+/**
+ * \brief           Get length of linear block at write address, limited by the end of the tail chunk
+ * \param[in]       buff: Segmented buffer
+ * \return          Linear write length, `0` when tail chunk has no free space
+ */
+lwrb_sz_t
+lwrb_seg_get_linear_block_write_length(const lwrb_seg_t* buff) {
+    if (!SEG_VALID(buff)) {
+        return 0;
+    }
+    return BUF_MIN(SEG_TAIL_FREE(buff), prv_get_room(buff));
+}
+
+#endif /* defined(LWRB_SEG) */
@@ -0,0 +1,130 @@
+/**
+ * \file            lwrb_fd_posix.c
+ * \brief           Lightweight ring buffer - file descriptor I/O for POSIX systems
+ */
+
+/*
+ * Copyright (c) 2024 Tilen MAJERLE
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the "Software"), to deal in the Software without restriction,
+ * including without limitation the rights to use, copy, modify, merge,
+ * publish, distribute, sublicense, and/or sell copies of the Software,
+ * and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE
+ * AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * This file is part of LwRB - Lightweight ring buffer library.
+ *
+ * Author:          Tilen MAJERLE <tilen@majerle.eu>
+ * Version:         v3.3.0
+ */
+#include "lwrb/lwrb.h"
+
+#if defined(LWRB_FD) && (defined(__unix__) || defined(__APPLE__))
+#include <errno.h>
+#include <sys/uio.h>
+#include <unistd.h>
+
+/**
+ * \brief           Convert up to `2` buffer spans to I/O vector for system call
+ * \param[in]       spans: Buffer spans, second one may be empty
+ * \param[out]      iov: Output I/O vector of `2` entries
+ * \return          Number of used entries in `iov`
+ */
+static int
+prv_spans_to_iov(const lwrb_iovec_t* spans, struct iovec* iov) {
+    iov[0].iov_base = spans[0].data;
+    iov[0].iov_len = spans[0].len;
+    iov[1].iov_base = spans[1].data;
+    iov[1].iov_len = spans[1].len;
+    return spans[1].len > 0 ? 2 : 1;
+}
+
+/**
+ * \brief           Read data from file descriptor directly to buffer memory.
+ *
+ * Free memory of the buffer, up to `2` linear blocks, is passed to single `readv` call,
+ * without intermediate copy. Write pointer is advanced once, for number of bytes actually read.
+ * Call is repeated when interrupted by a signal.
+ *
+ * \param[in]       buff: Ring buffer instance
+ * \param[in]       fd: File descriptor to read from, such as socket or pipe
+ * \param[in]       btw: Maximum number of bytes to read. Use `0` to read up to all free memory
+ * \return          Number of bytes written to buffer, `0` on end of file,
+ *                      `-1` on error with `errno` set. `errno` is set to `EAGAIN` (or `EWOULDBLOCK`)
+ *                      when non-blocking descriptor has no data, and to `ENOBUFS` when buffer is full
+ */
+ssize_t
+lwrb_write_from_fd(lwrb_t* buff, int fd, lwrb_sz_t btw) {
+    lwrb_iovec_t spans[2];
+    struct iovec iov[2];
+    ssize_t res;
+
+    if (!lwrb_is_ready(buff) || fd < 0) {
+        errno = EINVAL;
+        return -1;
+    }
+    if (lwrb_write_reserve(buff, btw > 0 ? btw : buff->size, spans) == 0) {
+        errno = ENOBUFS;
+        return -1;
+    }
+    do {
+        res = readv(fd, iov, prv_spans_to_iov(spans, iov));
+    } while (res < 0 && errno == EINTR);
+    if (res > 0) {
+        lwrb_write_commit(buff, (lwrb_sz_t)res);
+    }
+    return res;
+}
+
+/**
+ * \brief           Write buffer data directly to file descriptor.
+ *
+ * Buffer data, up to `2` linear blocks, is passed to single `writev` call,
+ * without intermediate copy. Read pointer is advanced once, for number of bytes actually written,
+ * hence data not accepted by the descriptor stays in the buffer.
+ * Call is repeated when interrupted by a signal.
+ *
+ * \param[in]       buff: Ring buffer instance
+ * \param[in]       fd: File descriptor to write to, such as socket or pipe
+ * \param[in]       btr: Maximum number of bytes to write. Use `0` to write all buffer data
+ * \return          Number of bytes read from buffer and written to descriptor, `0` when buffer is empty,
+ *                      `-1` on error with `errno` set. `errno` is set to `EAGAIN` (or `EWOULDBLOCK`)
+ *                      when non-blocking descriptor cannot accept data
+ */
+ssize_t
+lwrb_read_to_fd(lwrb_t* buff, int fd, lwrb_sz_t btr) {
+    lwrb_iovec_t spans[2];
+    struct iovec iov[2];
+    ssize_t res;
+
+    if (!lwrb_is_ready(buff) || fd < 0) {
+        errno = EINVAL;
+        return -1;
+    }
+    if (lwrb_read_acquire(buff, btr > 0 ? btr : buff->size, spans) == 0) {
+        return 0;
+    }
+    do {
+        res = writev(fd, iov, prv_spans_to_iov(spans, iov));
+    } while (res < 0 && errno == EINTR);
+    if (res > 0) {
+        lwrb_read_release(buff, (lwrb_sz_t)res);
+    }
+    return res;
+}
+
+#endif /* defined(LWRB_FD) && (defined(__unix__) || defined(__APPLE__)) */
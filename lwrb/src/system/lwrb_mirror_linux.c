@@ -0,0 +1,117 @@
+/**
+ * \file            lwrb_mirror_linux.c
+ * \brief           Lightweight ring buffer - mirrored buffer for Linux
+ */
+
+/*
+ * Copyright (c) 2024 Tilen MAJERLE
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the "Software"), to deal in the Software without restriction,
+ * including without limitation the rights to use, copy, modify, merge,
+ * publish, distribute, sublicense, and/or sell copies of the Software,
+ * and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE
+ * AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * This file is part of LwRB - Lightweight ring buffer library.
+ *
+ * Author:          Tilen MAJERLE <tilen@majerle.eu>
+ * Version:         v3.3.0
+ */
+#ifndef _GNU_SOURCE
+#define _GNU_SOURCE /* memfd_create */
+#endif
+#include "lwrb/lwrb.h"
+
+#if defined(LWRB_MIRROR) && defined(__linux__)
+#include <sys/mman.h>
+#include <unistd.h>
+
+/**
+ * \brief           Initialize mirrored buffer.
+ *
+ * Buffer memory is allocated by the library as shared memory object (`memfd_create`),
+ * that gets mapped twice in virtual memory, back to back. Byte at index `size + i` is the same
+ * physical byte as the one at index `i`, hence any read or write region up to `size` bytes
+ * is always one linear block, even when it crosses the end of the buffer.
+ *
+ * Linear block functions, such as \ref lwrb_get_linear_block_read_length,
+ * return complete number of available bytes, and read and write functions
+ * always use single memory copy.
+ *
+ * \note            Buffer must be freed with \ref lwrb_free_mirror
+ * \param[in]       buff: Ring buffer instance
+ * \param[in]       size: Size of buffer in units of bytes.
+ *                      Must be multiple of system page size
+ * \return          `1` on success, `0` otherwise
+ */
+uint8_t
+lwrb_init_mirror(lwrb_t* buff, lwrb_sz_t size) {
+    long page_size;
+    uint8_t* addr;
+    int fd;
+
+    page_size = sysconf(_SC_PAGESIZE);
+    if (buff == NULL || size == 0 || page_size <= 0 || (size % (lwrb_sz_t)page_size) != 0) {
+        return 0;
+    }
+
+    /* Physical memory, mapped twice below */
+    fd = memfd_create("lwrb", MFD_CLOEXEC);
+    if (fd < 0) {
+        return 0;
+    }
+    if (ftruncate(fd, (off_t)size) != 0) {
+        close(fd);
+        return 0;
+    }
+
+    /* Reserve contiguous address range for both mappings, then map the same memory at both halves */
+    addr = mmap(NULL, 2 * size, PROT_NONE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+    if (addr == MAP_FAILED) {
+        close(fd);
+        return 0;
+    }
+    if (mmap(addr, size, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_FIXED, fd, 0) == MAP_FAILED
+        || mmap(addr + size, size, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_FIXED, fd, 0) == MAP_FAILED) {
+        munmap(addr, 2 * size);
+        close(fd);
+        return 0;
+    }
+    close(fd); /* Mappings keep memory alive */
+
+    if (!lwrb_init(buff, addr, size)) {
+        munmap(addr, 2 * size);
+        return 0;
+    }
+    buff->linear_size = 2 * size;
+    return 1;
+}
+
+/**
+ * \brief           Free mirrored buffer, previously initialized with \ref lwrb_init_mirror
+ * \param[in]       buff: Ring buffer instance
+ */
+void
+lwrb_free_mirror(lwrb_t* buff) {
+    if (buff != NULL && buff->buff != NULL && buff->linear_size == 2 * buff->size) {
+        munmap(buff->buff, buff->linear_size);
+        buff->linear_size = buff->size;
+        lwrb_free(buff);
+    }
+}
+
+#endif /* defined(LWRB_MIRROR) && defined(__linux__) */
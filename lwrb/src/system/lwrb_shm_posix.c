@@ -0,0 +1,342 @@
+/**
+ * \file            lwrb_shm_posix.c
+ * \brief           Lightweight ring buffer - shared memory buffer between processes
+ */
+
+/*
+ * Copyright (c) 2024 Tilen MAJERLE
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the "Software"), to deal in the Software without restriction,
+ * including without limitation the rights to use, copy, modify, merge,
+ * publish, distribute, sublicense, and/or sell copies of the Software,
+ * and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE
+ * AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * This file is part of LwRB - Lightweight ring buffer library.
+ *
+ * Author:          Tilen MAJERLE <tilen@majerle.eu>
+ * Version:         v3.3.0
+ */
+#ifndef _GNU_SOURCE
+#define _GNU_SOURCE /* shm_open, ftruncate */
+#endif
+#include "lwrb/lwrb.h"
+#include "../lwrb/lwrb_priv.h"
+
+#if defined(LWRB_SHM)
+
+#if ATOMIC_LONG_LOCK_FREE != 2
+#error "LWRB_SHM requires lock-free atomic operations on lwrb_sz_t"
+#endif
+
+#define SHM_IS_VALID(s) ((s) != NULL && (s)->hdr != NULL && (s)->data != NULL)
+
+/**
+ * \brief           Initialize shared memory buffer in memory provided by application.
+ *
+ * Header is written to the beginning of memory, followed by the data area.
+ * Header contains no pointers, so memory can be shared between processes,
+ * that map it at different addresses. Other process uses \ref lwrb_shm_bind on its mapping.
+ *
+ * \param[out]      shm: Process local handle to initialize
+ * \param[in]       mem: Memory of at least \ref LWRB_SHM_MEM_SIZE bytes, aligned to cache line
+ * \param[in]       size: Size of data area in units of bytes, must be power of `2`
+ * \return          `1` on success, `0` otherwise
+ */
+uint8_t
+lwrb_shm_format(lwrb_shm_t* shm, void* mem, lwrb_sz_t size) {
+    lwrb_shm_hdr_t* hdr = mem;
+
+    if (shm == NULL || mem == NULL || size == 0 || (size & (size - 1)) != 0) {
+        return 0;
+    }
+    memset(hdr, 0x00, sizeof(*hdr));
+    hdr->version = LWRB_SHM_VERSION;
+    hdr->sz_size = (uint32_t)sizeof(lwrb_sz_t);
+    hdr->size = size;
+    hdr->data_offset = (lwrb_sz_t)sizeof(*hdr);
+    atomic_init(&hdr->w_ptr, 0);
+    atomic_init(&hdr->r_ptr, 0);
+
+    /* Magic is written last, other process checks it first */
+    atomic_thread_fence(memory_order_release);
+    hdr->magic = LWRB_SHM_MAGIC;
+
+    shm->hdr = hdr;
+    shm->data = (uint8_t*)mem + hdr->data_offset;
+    shm->size = hdr->size;
+    shm->map_size = 0;
+    return 1;
+}
+
+/**
+ * \brief           Bind process local handle to shared memory buffer, initialized by other process
+ * \param[out]      shm: Process local handle to initialize
+ * \param[in]       mem: Beginning of the shared memory, as mapped in this process
+ * \param[in]       mem_size: Size of mapped memory in units of bytes
+ * \return          `1` on success, `0` if memory does not hold valid buffer of compatible layout
+ */
+uint8_t
+lwrb_shm_bind(lwrb_shm_t* shm, void* mem, size_t mem_size) {
+    lwrb_shm_hdr_t* hdr = mem;
+    lwrb_sz_t size, data_offset;
+
+    if (shm == NULL || mem == NULL || mem_size < sizeof(*hdr) || hdr->magic != LWRB_SHM_MAGIC) {
+        return 0;
+    }
+    atomic_thread_fence(memory_order_acquire);
+
+    /* Validate local copies, other process may modify the header at any time */
+    size = hdr->size;
+    data_offset = hdr->data_offset;
+    if (hdr->version != LWRB_SHM_VERSION || hdr->sz_size != sizeof(lwrb_sz_t) || size == 0
+        || (size & (size - 1)) != 0 || data_offset < sizeof(*hdr) || data_offset > mem_size
+        || mem_size - data_offset < size) {
+        return 0;
+    }
+    shm->hdr = hdr;
+    shm->data = (uint8_t*)mem + data_offset;
+    shm->size = size;
+    shm->map_size = 0;
+    return 1;
+}
+
+/**
+ * \brief           Write data to shared memory buffer. Producer process only
+ * \param[in]       shm: Process local handle
+ * \param[in]       data: Data to write
+ * \param[in]       btw: Bytes To Write
+ * \return          Number of bytes written, limited by free memory
+ */
+lwrb_sz_t
+lwrb_shm_write(lwrb_shm_t* shm, const void* data, lwrb_sz_t btw) {
+    lwrb_sz_t w_ptr, r_ptr, size, idx, tocopy;
+
+    if (!SHM_IS_VALID(shm) || data == NULL || btw == 0) {
+        return 0;
+    }
+    size = shm->size;
+    w_ptr = atomic_load_explicit(&shm->hdr->w_ptr, memory_order_relaxed);
+    r_ptr = atomic_load_explicit(&shm->hdr->r_ptr, memory_order_acquire);
+    if (w_ptr - r_ptr > size) {
+        return 0; /* Indices corrupted by other process */
+    }
+    btw = BUF_MIN(btw, size - (w_ptr - r_ptr));
+    if (btw == 0) {
+        return 0;
+    }
+
+    idx = w_ptr & (size - 1);
+    tocopy = BUF_MIN(size - idx, btw);
+    memcpy(&shm->data[idx], data, tocopy);
+    if (btw > tocopy) {
+        memcpy(shm->data, (const uint8_t*)data + tocopy, btw - tocopy);
+    }
+    atomic_store_explicit(&shm->hdr->w_ptr, w_ptr + btw, memory_order_release);
+    return btw;
+}
+
+/**
+ * \brief           Read data from shared memory buffer. Consumer process only
+ * \param[in]       shm: Process local handle
+ * \param[out]      data: Output memory to copy data to
+ * \param[in]       btr: Bytes To Read
+ * \return          Number of bytes read
+ */
+lwrb_sz_t
+lwrb_shm_read(lwrb_shm_t* shm, void* data, lwrb_sz_t btr) {
+    lwrb_sz_t w_ptr, r_ptr, size, idx, tocopy;
+
+    if (!SHM_IS_VALID(shm) || data == NULL || btr == 0) {
+        return 0;
+    }
+    size = shm->size;
+    r_ptr = atomic_load_explicit(&shm->hdr->r_ptr, memory_order_relaxed);
+    w_ptr = atomic_load_explicit(&shm->hdr->w_ptr, memory_order_acquire);
+    if (w_ptr - r_ptr > size) {
+        return 0; /* Indices corrupted by other process */
+    }
+    btr = BUF_MIN(btr, w_ptr - r_ptr);
+    if (btr == 0) {
+        return 0;
+    }
+
+    idx = r_ptr & (size - 1);
+    tocopy = BUF_MIN(size - idx, btr);
+    memcpy(data, &shm->data[idx], tocopy);
+    if (btr > tocopy) {
+        memcpy((uint8_t*)data + tocopy, shm->data, btr - tocopy);
+    }
+    atomic_store_explicit(&shm->hdr->r_ptr, r_ptr + btr, memory_order_release);
+    return btr;
+}
+
+/**
+ * \brief           Get number of free bytes in shared memory buffer
+ * \param[in]       shm: Process local handle
+ * \return          Number of free bytes
+ */
+lwrb_sz_t
+lwrb_shm_get_free(const lwrb_shm_t* shm) {
+    lwrb_sz_t r_ptr, w_ptr;
+
+    if (!SHM_IS_VALID(shm)) {
+        return 0;
+    }
+    w_ptr = atomic_load_explicit(&shm->hdr->w_ptr, memory_order_acquire);
+    r_ptr = atomic_load_explicit(&shm->hdr->r_ptr, memory_order_acquire);
+    if (w_ptr - r_ptr > shm->size) {
+        return 0;
+    }
+    return shm->size - (w_ptr - r_ptr);
+}
+
+/**
+ * \brief           Get number of bytes ready to be read from shared memory buffer
+ * \param[in]       shm: Process local handle
+ * \return          Number of bytes in the buffer
+ */
+lwrb_sz_t
+lwrb_shm_get_full(const lwrb_shm_t* shm) {
+    lwrb_sz_t r_ptr, w_ptr;
+
+    if (!SHM_IS_VALID(shm)) {
+        return 0;
+    }
+    r_ptr = atomic_load_explicit(&shm->hdr->r_ptr, memory_order_acquire);
+    w_ptr = atomic_load_explicit(&shm->hdr->w_ptr, memory_order_acquire);
+    if (w_ptr - r_ptr > shm->size) {
+        return 0;
+    }
+    return w_ptr - r_ptr;
+}
+
+#if defined(__unix__) || defined(__APPLE__)
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+/**
+ * \brief           Create named shared memory object with initialized buffer and map it.
+ *
+ * Memory object is created with `shm_open` and must not exist yet.
+ * Other process maps it with \ref lwrb_shm_attach. Transfer of data is then
+ * memory copy only, without system calls.
+ *
+ * \note            Handle must be closed with \ref lwrb_shm_close, and memory object
+ *                  removed with \ref lwrb_shm_unlink when not needed anymore
+ * \param[out]      shm: Process local handle
+ * \param[in]       name: Name of shared memory object, such as `"/lwrb_capture"`
+ * \param[in]       size: Size of data area in units of bytes, must be power of `2`
+ * \return          `1` on success, `0` otherwise
+ */
+uint8_t
+lwrb_shm_create(lwrb_shm_t* shm, const char* name, lwrb_sz_t size) {
+    size_t map_size = LWRB_SHM_MEM_SIZE(size);
+    void* mem;
+    int fd;
+
+    if (shm == NULL || name == NULL || size == 0 || (size & (size - 1)) != 0) {
+        return 0;
+    }
+    fd = shm_open(name, O_RDWR | O_CREAT | O_EXCL, 0600);
+    if (fd < 0) {
+        return 0;
+    }
+    if (ftruncate(fd, (off_t)map_size) != 0) {
+        close(fd);
+        shm_unlink(name);
+        return 0;
+    }
+    mem = mmap(NULL, map_size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    close(fd);
+    if (mem == MAP_FAILED) {
+        shm_unlink(name);
+        return 0;
+    }
+    lwrb_shm_format(shm, mem, size);
+    shm->map_size = map_size;
+    return 1;
+}
+
+/**
+ * \brief           Map named shared memory object, created by \ref lwrb_shm_create in other process
+ * \note            Handle must be closed with \ref lwrb_shm_close
+ * \param[out]      shm: Process local handle
+ * \param[in]       name: Name of shared memory object
+ * \return          `1` on success, `0` if object does not exist or is not initialized yet
+ */
+uint8_t
+lwrb_shm_attach(lwrb_shm_t* shm, const char* name) {
+    struct stat st;
+    void* mem;
+    int fd;
+
+    if (shm == NULL || name == NULL) {
+        return 0;
+    }
+    fd = shm_open(name, O_RDWR, 0);
+    if (fd < 0) {
+        return 0;
+    }
+    if (fstat(fd, &st) != 0 || (size_t)st.st_size < sizeof(lwrb_shm_hdr_t)) {
+        close(fd);
+        return 0;
+    }
+    mem = mmap(NULL, (size_t)st.st_size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    close(fd);
+    if (mem == MAP_FAILED) {
+        return 0;
+    }
+    if (!lwrb_shm_bind(shm, mem, (size_t)st.st_size)) {
+        munmap(mem, (size_t)st.st_size);
+        return 0;
+    }
+    shm->map_size = (size_t)st.st_size;
+    return 1;
+}
+
+/**
+ * \brief           Unmap shared memory, mapped by \ref lwrb_shm_create or \ref lwrb_shm_attach
+ * \param[in]       shm: Process local handle
+ */
+void
+lwrb_shm_close(lwrb_shm_t* shm) {
+    if (shm != NULL && shm->hdr != NULL && shm->map_size > 0) {
+        munmap(shm->hdr, shm->map_size);
+    }
+    if (shm != NULL) {
+        shm->hdr = NULL;
+        shm->data = NULL;
+        shm->map_size = 0;
+    }
+}
+
+/**
+ * \brief           Remove named shared memory object. Existing mappings stay valid
+ * \param[in]       name: Name of shared memory object
+ * \return          `1` on success, `0` otherwise
+ */
+uint8_t
+lwrb_shm_unlink(const char* name) {
+    return name != NULL && shm_unlink(name) == 0;
+}
+
+#endif /* defined(__unix__) || defined(__APPLE__) */
+
+#endif /* defined(LWRB_SHM) */
@@ -230,6 +230,12 @@ test_run(void) {
         FIND_TEST("1234", 3, 0, 1); /* Must find it */
         FIND_TEST("4567", 3, 0, 1); /* Must find it */
         FIND_TEST("1234", 3, 1, 0); /* Must not find it - start offset is later */
+        FIND_TEST("8", 1, 0, 1);    /* Single byte at the end */
+        FIND_TEST("9", 1, 0, 0);    /* Single byte, not in buffer */
+        FIND_TEST("2345678", 7, 0, 1);
+        FIND_TEST("12345678", 8, 0, 1); /* Long needle, across the end of the buffer */
+        FIND_TEST("12345679", 8, 0, 0); /* Long needle, last byte differs */
+        FIND_TEST("02345678", 8, 0, 0); /* Long needle, first byte differs */
 
 #undef FIND_TEST
     }
@@ -294,6 +300,143 @@ test_run(void) {
 #undef PEEK_TEST
     }
 
+    printf("Vectored read/write test\r\n");
+    {
+        uint8_t hdr[2], payload[3], trailer[8];
+        lwrb_sz_t written, read;
+        uint8_t success;
+#define IOV_TEST(_cond_)                                                                                               \
+    do {                                                                                                               \
+        if (!(_cond_)) {                                                                                               \
+            printf("Test failed on line %u\r\n", (unsigned)__LINE__);                                                  \
+            retval = -1;                                                                                               \
+        }                                                                                                              \
+    } while (0)
+
+        lwrb_iovec_t wiov[] = {
+            {.data = "AB", .len = 2},
+            {.data = NULL, .len = 5}, /* Skipped */
+            {.data = "cde", .len = 3},
+            {.data = "XY", .len = 2},
+        };
+        lwrb_iovec_t riov[] = {
+            {.data = hdr, .len = sizeof(hdr)},
+            {.data = payload, .len = sizeof(payload)},
+            {.data = trailer, .len = sizeof(trailer)},
+        };
+
+        /* Start close to the end, so that data wraps */
+        lwrb_reset(&buff);
+        lwrb_advance(&buff, 6);
+        lwrb_skip(&buff, 6);
+
+        written = lwrb_writev(&buff, wiov, sizeof(wiov) / sizeof(wiov[0]));
+        IOV_TEST(written == 7);
+        IOV_TEST(buff.w_ptr == 4);
+        IOV_TEST(lwrb_peek(&buff, 0, tmp, 7) == 7 && memcmp(tmp, "ABcdeXY", 7) == 0);
+
+        /* All or nothing */
+        success = lwrb_writev_ex(&buff, wiov, sizeof(wiov) / sizeof(wiov[0]), &written, LWRB_FLAG_WRITE_ALL);
+        IOV_TEST(success == 0);
+        IOV_TEST(lwrb_get_full(&buff) == 7);
+        written = lwrb_writev(&buff, wiov, sizeof(wiov) / sizeof(wiov[0]));
+        IOV_TEST(written == 1);
+
+        /* Scatter to blocks in order */
+        success = lwrb_readv_ex(&buff, riov, sizeof(riov) / sizeof(riov[0]), &read, LWRB_FLAG_READ_ALL);
+        IOV_TEST(success == 0);
+        read = lwrb_readv(&buff, riov, sizeof(riov) / sizeof(riov[0]));
+        IOV_TEST(read == 8);
+        IOV_TEST(memcmp(hdr, "AB", 2) == 0 && memcmp(payload, "cde", 3) == 0 && memcmp(trailer, "XYA", 3) == 0);
+        IOV_TEST(lwrb_get_full(&buff) == 0);
+
+        /* Invalid input */
+        IOV_TEST(lwrb_writev(&buff, NULL, 1) == 0);
+        IOV_TEST(lwrb_writev(&buff, wiov, 0) == 0);
+        IOV_TEST(lwrb_readv(&buff, riov, sizeof(riov) / sizeof(riov[0])) == 0);
+#undef IOV_TEST
+    }
+
+    printf("Reserve/commit and acquire/release test\r\n");
+    {
+        lwrb_iovec_t spans[2];
+#define SPAN_TEST(_cond_)                                                                                              \
+    do {                                                                                                               \
+        if (!(_cond_)) {                                                                                               \
+            printf("Test failed on line %u\r\n", (unsigned)__LINE__);                                                  \
+            retval = -1;                                                                                               \
+        }                                                                                                              \
+    } while (0)
+
+        /* Start close to the end, so that free memory wraps */
+        lwrb_reset(&buff);
+        lwrb_advance(&buff, 6);
+        lwrb_skip(&buff, 6);
+
+        len = lwrb_write_reserve(&buff, 5, spans);
+        SPAN_TEST(len == 5);
+        SPAN_TEST(spans[0].data == &lwrb_data[6] && spans[0].len == 3);
+        SPAN_TEST(spans[1].data == &lwrb_data[0] && spans[1].len == 2);
+        memcpy(spans[0].data, "abc", 3);
+        memcpy(spans[1].data, "de", 2);
+        SPAN_TEST(lwrb_get_full(&buff) == 0); /* Not visible before commit */
+        SPAN_TEST(lwrb_write_commit(&buff, len) == 5);
+        SPAN_TEST(buff.w_ptr == 2);
+
+        /* Reservation is limited by free memory */
+        len = lwrb_write_reserve(&buff, 100, spans);
+        SPAN_TEST(len == 3 && spans[0].len == 3 && spans[1].len == 0 && spans[1].data == NULL);
+
+        len = lwrb_read_acquire(&buff, 100, spans);
+        SPAN_TEST(len == 5);
+        SPAN_TEST(spans[0].len == 3 && memcmp(spans[0].data, "abc", 3) == 0);
+        SPAN_TEST(spans[1].len == 2 && memcmp(spans[1].data, "de", 2) == 0);
+        SPAN_TEST(lwrb_read_release(&buff, len) == 5);
+        SPAN_TEST(lwrb_get_full(&buff) == 0);
+
+        /* Nothing to acquire */
+        len = lwrb_read_acquire(&buff, 100, spans);
+        SPAN_TEST(len == 0 && spans[0].data == NULL && spans[1].data == NULL);
+        SPAN_TEST(lwrb_write_reserve(NULL, 1, spans) == 0);
+#undef SPAN_TEST
+    }
+
+    printf("Read until delimiter test\r\n");
+    {
+        uint8_t frame[8];
+#define UNTIL_TEST(_cond_)                                                                                             \
+    do {                                                                                                               \
+        if (!(_cond_)) {                                                                                               \
+            printf("Test failed on line %u\r\n", (unsigned)__LINE__);                                                  \
+            retval = -1;                                                                                               \
+        }                                                                                                              \
+    } while (0)
+
+        /* Frames cross the end of the buffer */
+        lwrb_reset(&buff);
+        lwrb_advance(&buff, 5);
+        lwrb_skip(&buff, 5);
+        lwrb_write(&buff, "ab\ncde\nf", 8);
+
+        UNTIL_TEST(lwrb_count_byte(&buff, '\n') == 2);
+        UNTIL_TEST(lwrb_count_byte(&buff, 'x') == 0);
+        UNTIL_TEST(lwrb_read_until(&buff, '\n', frame, sizeof(frame)) == 3 && memcmp(frame, "ab\n", 3) == 0);
+        UNTIL_TEST(lwrb_read_until(&buff, '\n', frame, sizeof(frame)) == 4 && memcmp(frame, "cde\n", 4) == 0);
+        UNTIL_TEST(lwrb_count_byte(&buff, '\n') == 0);
+
+        /* Incomplete frame stays in the buffer */
+        UNTIL_TEST(lwrb_read_until(&buff, '\n', frame, sizeof(frame)) == 0);
+        UNTIL_TEST(lwrb_get_full(&buff) == 1);
+
+        /* Frame longer than output array is read in parts */
+        lwrb_write(&buff, "ghij\n", 5);
+        UNTIL_TEST(lwrb_read_until(&buff, '\n', frame, 3) == 3 && memcmp(frame, "fgh", 3) == 0);
+        UNTIL_TEST(lwrb_read_until(&buff, '\n', frame, 3) == 3 && memcmp(frame, "ij\n", 3) == 0);
+        UNTIL_TEST(lwrb_get_full(&buff) == 0);
+        UNTIL_TEST(lwrb_read_until(&buff, '\n', frame, sizeof(frame)) == 0);
+#undef UNTIL_TEST
+    }
+
     printf("Done!\r\n");
     return retval;
 }
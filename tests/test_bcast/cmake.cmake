@@ -0,0 +1,11 @@
+# CMake include file
+
+# Add more sources
+target_sources(${CMAKE_PROJECT_NAME} PRIVATE
+    ${CMAKE_CURRENT_LIST_DIR}/test_bcast.c
+)
+target_compile_definitions(lwrb PUBLIC LWRB_BCAST LWRB_WAIT)
+
+# Test blocks reader thread, that broadcast write must wake
+find_package(Threads REQUIRED)
+target_link_libraries(${CMAKE_PROJECT_NAME} PRIVATE Threads::Threads)
@@ -0,0 +1,96 @@
+#include <pthread.h>
+#include <stdio.h>
+#include <string.h>
+#include <time.h>
+#include "lwrb/lwrb.h"
+
+uint8_t lwrb_data[16 + 1];
+lwrb_bcast_t bc;
+lwrb_t readers[3];
+
+#define BCAST_TEST(_cond_)                                                                                             \
+    do {                                                                                                               \
+        if (!(_cond_)) {                                                                                               \
+            printf("Test failed on line %u\r\n", (unsigned)__LINE__);                                                  \
+            retval = -1;                                                                                               \
+        }                                                                                                              \
+    } while (0)
+
+static void*
+waiting_reader_thread(void* arg) {
+    (void)arg;
+    return (void*)(uintptr_t)lwrb_read_wait(&readers[0], 3, 2000);
+}
+
+int
+test_run(void) {
+    int retval = 0;
+    uint8_t tmp[32];
+
+    BCAST_TEST(!lwrb_bcast_init(&bc, lwrb_data, sizeof(lwrb_data), readers, 0));
+    BCAST_TEST(lwrb_bcast_init(&bc, lwrb_data, sizeof(lwrb_data), readers, 3));
+    BCAST_TEST(lwrb_bcast_get_free(&bc) == 16);
+
+    /* Data is written once and visible to every reader */
+    BCAST_TEST(lwrb_bcast_write(&bc, "0123456789", 10) == 10);
+    for (size_t i = 0; i < 3; ++i) {
+        BCAST_TEST(lwrb_get_full(&readers[i]) == 10);
+        BCAST_TEST(lwrb_bcast_is_active(&bc, i));
+    }
+    BCAST_TEST(lwrb_bcast_get_free(&bc) == 6);
+
+    /* Readers progress independently, free memory follows the slowest one */
+    BCAST_TEST(lwrb_read(&readers[0], tmp, 10) == 10 && memcmp(tmp, "0123456789", 10) == 0);
+    BCAST_TEST(lwrb_peek(&readers[1], 2, tmp, 3) == 3 && memcmp(tmp, "234", 3) == 0);
+    BCAST_TEST(lwrb_skip(&readers[1], 8) == 8);
+    BCAST_TEST(lwrb_read(&readers[2], tmp, 4) == 4 && memcmp(tmp, "0123", 4) == 0);
+    BCAST_TEST(lwrb_bcast_get_free(&bc) == 10);
+
+    /* Write wraps around the end of memory */
+    BCAST_TEST(lwrb_bcast_write(&bc, "abcdefghijklmnop", 16) == 10);
+    BCAST_TEST(lwrb_get_full(&readers[0]) == 10);
+    BCAST_TEST(lwrb_get_full(&readers[1]) == 12);
+    BCAST_TEST(lwrb_get_full(&readers[2]) == 16);
+    BCAST_TEST(lwrb_get_linear_block_read_length(&readers[0]) == 7);
+    BCAST_TEST(memcmp(lwrb_get_linear_block_read_address(&readers[0]), "abcdefg", 7) == 0);
+    BCAST_TEST(lwrb_read(&readers[1], tmp, sizeof(tmp)) == 12 && memcmp(tmp, "89abcdefghij", 12) == 0);
+    BCAST_TEST(lwrb_bcast_write(&bc, "X", 1) == 0);
+
+    /* Laggard is detached, when it has no room for new data */
+    lwrb_bcast_set_drop_laggards(&bc, 1);
+    BCAST_TEST(lwrb_read(&readers[0], tmp, sizeof(tmp)) == 10 && memcmp(tmp, "abcdefghij", 10) == 0);
+    BCAST_TEST(lwrb_bcast_write(&bc, "XYZ", 3) == 3);
+    BCAST_TEST(!lwrb_bcast_is_active(&bc, 2));
+    BCAST_TEST(lwrb_bcast_is_active(&bc, 0) && lwrb_bcast_is_active(&bc, 1));
+    BCAST_TEST(lwrb_get_full(&readers[0]) == 3 && lwrb_get_full(&readers[1]) == 3);
+    BCAST_TEST(lwrb_bcast_get_free(&bc) == 13);
+
+    /* Detached reader attaches again at next write, and gets new data only */
+    BCAST_TEST(lwrb_bcast_attach(&bc, 2));
+    BCAST_TEST(!lwrb_bcast_is_active(&bc, 2));
+    BCAST_TEST(lwrb_bcast_write(&bc, "uvw", 3) == 3);
+    BCAST_TEST(lwrb_bcast_is_active(&bc, 2));
+    BCAST_TEST(lwrb_read(&readers[2], tmp, sizeof(tmp)) == 3 && memcmp(tmp, "uvw", 3) == 0);
+    BCAST_TEST(lwrb_read(&readers[0], tmp, sizeof(tmp)) == 6 && memcmp(tmp, "XYZuvw", 6) == 0);
+    BCAST_TEST(lwrb_bcast_get_free(&bc) == 10);
+
+    /* Reader blocked on its own handle is woken by broadcast write */
+    {
+        struct timespec delay = {.tv_sec = 0, .tv_nsec = 50 * 1000000L}, t0, t1;
+        pthread_t thread;
+        void* res = NULL;
+
+        BCAST_TEST(lwrb_get_full(&readers[0]) == 0);
+        clock_gettime(CLOCK_MONOTONIC, &t0);
+        pthread_create(&thread, NULL, waiting_reader_thread, NULL);
+        nanosleep(&delay, NULL);
+        BCAST_TEST(lwrb_bcast_write(&bc, "rst", 3) == 3);
+        pthread_join(thread, &res);
+        clock_gettime(CLOCK_MONOTONIC, &t1);
+        BCAST_TEST(res != NULL);
+        BCAST_TEST((t1.tv_sec - t0.tv_sec) * 1000 + (t1.tv_nsec - t0.tv_nsec) / 1000000 < 1000);
+        BCAST_TEST(lwrb_read(&readers[0], tmp, sizeof(tmp)) == 3 && memcmp(tmp, "rst", 3) == 0);
+    }
+
+    return retval;
+}
@@ -0,0 +1,7 @@
+# CMake include file
+
+# Basic test, with producer and consumer state placed on separate cache lines
+target_sources(${CMAKE_PROJECT_NAME} PRIVATE
+    ${CMAKE_CURRENT_LIST_DIR}/../test_basic/test_basic.c
+)
+target_compile_definitions(lwrb PUBLIC LWRB_CACHELINE_ISOLATE)
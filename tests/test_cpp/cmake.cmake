@@ -0,0 +1,12 @@
+# CMake include file
+
+enable_language(CXX)
+if(CMAKE_CXX_COMPILER_ID STREQUAL "GNU")
+    set(CMAKE_CXX_FLAGS "${CMAKE_CXX_FLAGS} -Wall -Wextra -Wpedantic")
+endif()
+
+# Add more sources
+target_sources(${CMAKE_PROJECT_NAME} PRIVATE
+    ${CMAKE_CURRENT_LIST_DIR}/test_cpp.cpp
+)
+target_compile_features(${CMAKE_PROJECT_NAME} PRIVATE cxx_std_20)
@@ -0,0 +1,152 @@
+#include <cstdio>
+#include <cstring>
+#include <memory>
+#include <string>
+#include "lwrb/lwrb.hpp"
+
+extern "C" {
+#include "test.h"
+}
+
+#define RING_TEST(_cond_)                                                                                              \
+    do {                                                                                                               \
+        if (!(_cond_)) {                                                                                               \
+            printf("Test failed on line %u\r\n", (unsigned)__LINE__);                                                  \
+            retval = -1;                                                                                               \
+        }                                                                                                              \
+    } while (0)
+
+/* Element type, that counts live instances */
+struct tracked {
+    static int live;
+    int val;
+
+    explicit tracked(int v) : val(v) { ++live; }
+
+    tracked(const tracked& o) : val(o.val) { ++live; }
+
+    tracked(tracked&& o) noexcept : val(o.val) {
+        o.val = -1;
+        ++live;
+    }
+
+    tracked&
+    operator=(tracked&& o) noexcept {
+        val = o.val;
+        o.val = -1;
+        return *this;
+    }
+
+    ~tracked() { --live; }
+};
+
+int tracked::live = 0;
+
+int
+test_run(void) {
+    int retval = 0;
+
+    /* Typed ring, move only type */
+    {
+        Lwrb::ring<std::unique_ptr<int>, 3> r;
+        std::unique_ptr<int> out;
+
+        static_assert(decltype(r)::capacity() == 3, "Invalid capacity");
+        RING_TEST(r.empty());
+        RING_TEST(r.push(std::make_unique<int>(1)));
+        RING_TEST(r.emplace(new int(2)));
+        RING_TEST(r.push(std::make_unique<int>(3)));
+        RING_TEST(r.full());
+        RING_TEST(!r.push(std::make_unique<int>(4)));
+        RING_TEST(r.pop(out) && *out == 1);
+        RING_TEST(r.push(std::make_unique<int>(5)));
+
+        auto p = r.pop();
+        RING_TEST(p.has_value() && **p == 2);
+        RING_TEST(r.pop(out) && *out == 3);
+        RING_TEST(r.pop(out) && *out == 5);
+        RING_TEST(!r.pop().has_value());
+        RING_TEST(r.size() == 0);
+    }
+
+    /* Many cycles over non power of 2 capacity */
+    {
+        Lwrb::ring<int, 5> r;
+        int expected = 0, next = 0, val;
+
+        for (int i = 0; i < 100; ++i) {
+            while (r.push(next)) {
+                ++next;
+            }
+            RING_TEST(r.size() == 5);
+            for (int k = 0; k < (i % 5) + 1; ++k) {
+                RING_TEST(r.pop(val) && val == expected);
+                ++expected;
+            }
+        }
+    }
+
+    /* Element lifetime */
+    {
+        {
+            Lwrb::ring<tracked, 4> r;
+            tracked t(7);
+
+            RING_TEST(r.push(t));
+            RING_TEST(r.emplace(8));
+            RING_TEST(r.emplace(9));
+            RING_TEST(tracked::live == 4);
+            RING_TEST(r.pop(t) && t.val == 7);
+            RING_TEST(tracked::live == 3);
+        }
+        RING_TEST(tracked::live == 0);
+    }
+
+    /* Spans over both readable segments */
+    {
+        Lwrb::ring<int, 4> r;
+        int val;
+
+        for (int i = 0; i < 4; ++i) {
+            r.push(i);
+        }
+        r.pop(val);
+        r.pop(val);
+        r.push(4);
+
+        auto [s0, s1] = r.readable();
+        RING_TEST(s0.size() == 2 && s0[0] == 2 && s0[1] == 3);
+        RING_TEST(s1.size() == 1 && s1[0] == 4);
+        RING_TEST(r.consume(10) == 3);
+        RING_TEST(r.empty());
+
+        auto [e0, e1] = r.readable();
+        RING_TEST(e0.empty() && e1.empty());
+    }
+
+    /* Byte buffer on top of C library */
+    {
+        Lwrb::buffer<8> b;
+        uint8_t data[8];
+
+        RING_TEST(b.capacity() == 8);
+        RING_TEST(b.free_size() == 8);
+        RING_TEST(b.write("abcdef", 6) == 6);
+        RING_TEST(b.read(data, 4) == 4 && memcmp(data, "abcd", 4) == 0);
+        RING_TEST(b.write("ghijkl", 6) == 6);
+        RING_TEST(b.size() == 8);
+
+        auto [s0, s1] = b.readable();
+        RING_TEST(s0.size() + s1.size() == 8);
+        RING_TEST(!s1.empty());
+        RING_TEST(memcmp(s0.data(), "efghijkl", s0.size()) == 0);
+        RING_TEST(memcmp(s1.data(), "efghijkl" + s0.size(), s1.size()) == 0);
+        RING_TEST(b.skip(8) == 8);
+
+        /* C structure tag stays usable from C++ code */
+        struct lwrb* raw = b.handle();
+        RING_TEST(lwrb_get_full(raw) == 0);
+    }
+
+    return retval;
+}
@@ -0,0 +1,101 @@
+#include <stdint.h>
+#include <stdio.h>
+#include <string.h>
+#include "lwrb/lwrb.h"
+
+/* Element with size, that does not divide typical buffer sizes */
+typedef struct {
+    uint32_t id;
+    uint8_t payload[44];
+} elem_t;
+
+#define ELEM_COUNT 5
+
+elem_t lwrb_data[LWRB_ELEM_BUFF_SIZE(1, ELEM_COUNT)];
+lwrb_t buff;
+
+#define ELEM_TEST(_cond_)                                                                                              \
+    do {                                                                                                               \
+        if (!(_cond_)) {                                                                                               \
+            printf("Test failed on line %u\r\n", (unsigned)__LINE__);                                                  \
+            retval = -1;                                                                                               \
+        }                                                                                                              \
+    } while (0)
+
+static void
+prv_fill(elem_t* e, size_t count, uint32_t first_id) {
+    for (size_t i = 0; i < count; ++i) {
+        e[i].id = first_id + (uint32_t)i;
+        memset(e[i].payload, (int)(first_id + i), sizeof(e[i].payload));
+    }
+}
+
+static int
+prv_check(const elem_t* e, size_t count, uint32_t first_id) {
+    for (size_t i = 0; i < count; ++i) {
+        if (e[i].id != first_id + i || e[i].payload[0] != (uint8_t)(first_id + i)
+            || e[i].payload[sizeof(e[i].payload) - 1] != (uint8_t)(first_id + i)) {
+            return 0;
+        }
+    }
+    return 1;
+}
+
+int
+test_run(void) {
+    int retval = 0;
+    elem_t in[ELEM_COUNT + 2], out[ELEM_COUNT + 2];
+    uint32_t next_w = 0, next_r = 0;
+
+    ELEM_TEST(!lwrb_init_elem(&buff, lwrb_data, 0, ELEM_COUNT));
+    ELEM_TEST(!lwrb_init_elem(&buff, lwrb_data, sizeof(elem_t), 0));
+    ELEM_TEST(lwrb_init_elem(&buff, lwrb_data, sizeof(elem_t), ELEM_COUNT));
+    ELEM_TEST(lwrb_get_free_n(&buff) == ELEM_COUNT);
+    ELEM_TEST(lwrb_get_full_n(&buff) == 0);
+
+    /* Write more than fits, only whole elements are accepted */
+    prv_fill(in, ELEM_COUNT + 2, next_w);
+    ELEM_TEST(lwrb_write_n(&buff, in, ELEM_COUNT + 2) == ELEM_COUNT);
+    next_w += ELEM_COUNT;
+    ELEM_TEST(lwrb_get_full(&buff) == ELEM_COUNT * sizeof(elem_t));
+    ELEM_TEST(lwrb_write_n(&buff, in, 1) == 0);
+
+    /* Peek */
+    ELEM_TEST(lwrb_peek_n(&buff, 2, out, ELEM_COUNT) == ELEM_COUNT - 2);
+    ELEM_TEST(prv_check(out, ELEM_COUNT - 2, 2));
+    ELEM_TEST(lwrb_peek_n(&buff, ELEM_COUNT, out, 1) == 0);
+
+    /* Cycle through the buffer many times with different counts */
+    for (size_t i = 0; i < 100; ++i) {
+        lwrb_sz_t n = (lwrb_sz_t)(i % 3) + 1, r, w;
+
+        r = lwrb_read_n(&buff, out, n);
+        ELEM_TEST(r == n);
+        ELEM_TEST(prv_check(out, r, next_r));
+        next_r += (uint32_t)r;
+
+        /* Linear blocks always start at element boundary and hold whole elements */
+        ELEM_TEST(((uint8_t*)lwrb_get_linear_block_read_address(&buff) - (uint8_t*)lwrb_data) % sizeof(elem_t) == 0);
+        ELEM_TEST(lwrb_get_linear_block_read_length(&buff) % sizeof(elem_t) == 0);
+        ELEM_TEST(((uint8_t*)lwrb_get_linear_block_write_address(&buff) - (uint8_t*)lwrb_data) % sizeof(elem_t) == 0);
+        ELEM_TEST(lwrb_get_linear_block_write_length(&buff) % sizeof(elem_t) == 0);
+
+        prv_fill(in, ELEM_COUNT, next_w);
+        w = lwrb_write_n(&buff, in, ELEM_COUNT);
+        ELEM_TEST(w == r);
+        next_w += (uint32_t)w;
+        ELEM_TEST(lwrb_get_full_n(&buff) == ELEM_COUNT);
+    }
+
+    /* Drain */
+    ELEM_TEST(lwrb_read_n(&buff, out, ELEM_COUNT + 2) == ELEM_COUNT);
+    ELEM_TEST(prv_check(out, ELEM_COUNT, next_r));
+    ELEM_TEST(lwrb_read_n(&buff, out, 1) == 0);
+
+    /* Plain byte buffer has element size of 1 */
+    ELEM_TEST(lwrb_init(&buff, lwrb_data, 9));
+    ELEM_TEST(lwrb_write_n(&buff, "0123456789", 10) == 8);
+    ELEM_TEST(lwrb_get_full_n(&buff) == 8);
+
+    return retval;
+}
@@ -0,0 +1,80 @@
+#include <errno.h>
+#include <fcntl.h>
+#include <stdio.h>
+#include <string.h>
+#include <unistd.h>
+#include "lwrb/lwrb.h"
+
+uint8_t lwrb_data[8 + 1];
+lwrb_t buff;
+
+uint8_t tmp[16];
+
+#define FD_TEST(_cond_)                                                                                                \
+    do {                                                                                                               \
+        if (!(_cond_)) {                                                                                               \
+            printf("Test failed on line %u\r\n", (unsigned)__LINE__);                                                  \
+            retval = -1;                                                                                               \
+        }                                                                                                              \
+    } while (0)
+
+int
+test_run(void) {
+    int retval = 0;
+    int fds[2];
+
+    lwrb_init(&buff, lwrb_data, sizeof(lwrb_data));
+    if (pipe(fds) != 0) {
+        printf("Cannot create pipe\r\n");
+        return -1;
+    }
+    fcntl(fds[0], F_SETFL, fcntl(fds[0], F_GETFL) | O_NONBLOCK);
+
+    printf("Invalid input test\r\n");
+    {
+        FD_TEST(lwrb_write_from_fd(NULL, fds[0], 0) == -1 && errno == EINVAL);
+        FD_TEST(lwrb_read_to_fd(&buff, -1, 0) == -1 && errno == EINVAL);
+    }
+
+    printf("Fill from descriptor test\r\n");
+    {
+        /* Non-blocking descriptor without data */
+        FD_TEST(lwrb_write_from_fd(&buff, fds[0], 0) == -1 && (errno == EAGAIN || errno == EWOULDBLOCK));
+
+        /* Data crosses the end of the buffer, read with one call */
+        lwrb_advance(&buff, 6);
+        lwrb_skip(&buff, 6);
+        FD_TEST(write(fds[1], "0123456789", 10) == 10);
+        FD_TEST(lwrb_write_from_fd(&buff, fds[0], 3) == 3); /* Limited by request */
+        FD_TEST(lwrb_write_from_fd(&buff, fds[0], 0) == 5); /* Limited by free memory */
+        FD_TEST(lwrb_get_full(&buff) == 8);
+        FD_TEST(lwrb_write_from_fd(&buff, fds[0], 0) == -1 && errno == ENOBUFS);
+        FD_TEST(lwrb_read(&buff, tmp, sizeof(tmp)) == 8 && memcmp(tmp, "01234567", 8) == 0);
+        FD_TEST(lwrb_write_from_fd(&buff, fds[0], 0) == 2);
+        FD_TEST(lwrb_read(&buff, tmp, sizeof(tmp)) == 2 && memcmp(tmp, "89", 2) == 0);
+    }
+
+    printf("Drain to descriptor test\r\n");
+    {
+        FD_TEST(lwrb_read_to_fd(&buff, fds[1], 0) == 0); /* Empty buffer */
+
+        lwrb_reset(&buff);
+        lwrb_advance(&buff, 5);
+        lwrb_skip(&buff, 5);
+        lwrb_write(&buff, "abcdefgh", 8);
+        FD_TEST(lwrb_read_to_fd(&buff, fds[1], 2) == 2);
+        FD_TEST(lwrb_read_to_fd(&buff, fds[1], 0) == 6);
+        FD_TEST(lwrb_get_full(&buff) == 0);
+        FD_TEST(read(fds[0], tmp, sizeof(tmp)) == 8 && memcmp(tmp, "abcdefgh", 8) == 0);
+    }
+
+    printf("End of file test\r\n");
+    {
+        close(fds[1]);
+        FD_TEST(lwrb_write_from_fd(&buff, fds[0], 0) == 0);
+        close(fds[0]);
+    }
+
+    printf("Done\r\n");
+    return retval;
+}
@@ -0,0 +1,12 @@
+# CMake include file
+
+# Wait test, with core functions built in each compilation unit from the header, in strict ISO C mode
+target_sources(${CMAKE_PROJECT_NAME} PRIVATE
+    ${CMAKE_CURRENT_LIST_DIR}/../test_wait/test_wait.c
+)
+target_compile_definitions(lwrb PUBLIC LWRB_HEADER_ONLY LWRB_WAIT)
+set_target_properties(${CMAKE_PROJECT_NAME} lwrb lwrb_ex PROPERTIES C_STANDARD 11 C_EXTENSIONS OFF)
+
+# Test runs producer thread against blocked consumer
+find_package(Threads REQUIRED)
+target_link_libraries(${CMAKE_PROJECT_NAME} PRIVATE Threads::Threads)
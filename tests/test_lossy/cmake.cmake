@@ -0,0 +1,11 @@
+# CMake include file
+
+# Add more sources
+target_sources(${CMAKE_PROJECT_NAME} PRIVATE
+    ${CMAKE_CURRENT_LIST_DIR}/test_lossy.c
+)
+target_compile_definitions(lwrb PUBLIC LWRB_LOSSY)
+
+# Test runs producer thread, that overruns consumer
+find_package(Threads REQUIRED)
+target_link_libraries(${CMAKE_PROJECT_NAME} PRIVATE Threads::Threads)
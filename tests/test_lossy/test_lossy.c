@@ -0,0 +1,112 @@
+#include <pthread.h>
+#include <sched.h>
+#include <stdio.h>
+#include <string.h>
+#include "lwrb/lwrb.h"
+
+uint8_t lwrb_data[64];
+lwrb_t buff;
+
+#define LOSSY_TEST(_cond_)                                                                                             \
+    do {                                                                                                               \
+        if (!(_cond_)) {                                                                                               \
+            printf("Test failed on line %u\r\n", (unsigned)__LINE__);                                                  \
+            retval = -1;                                                                                               \
+        }                                                                                                              \
+    } while (0)
+
+/* Byte value at stream position, differs for positions that share buffer memory */
+static uint8_t
+prv_pattern(lwrb_sz_t pos) {
+    return (uint8_t)((pos * 2654435761UL) >> 13);
+}
+
+#define STREAM_LEN (1024UL * 1024UL)
+
+static volatile int producer_done;
+
+static void*
+prv_producer_thread(void* arg) {
+    uint8_t chunk[37];
+    lwrb_sz_t pos = 0;
+
+    (void)arg;
+    while (pos < STREAM_LEN) {
+        for (size_t i = 0; i < sizeof(chunk); ++i) {
+            chunk[i] = prv_pattern(pos + i);
+        }
+        lwrb_write_lossy(&buff, chunk, sizeof(chunk));
+        pos += sizeof(chunk);
+        if ((pos % 16) == 0) {
+            sched_yield(); /* Let reader keep up partially */
+        }
+    }
+    producer_done = 1;
+    return NULL;
+}
+
+int
+test_run(void) {
+    int retval = 0;
+    uint8_t in[200], out[200];
+    lwrb_sz_t lost, len, pos, total_lost;
+
+    for (size_t i = 0; i < sizeof(in); ++i) {
+        in[i] = prv_pattern(i);
+    }
+
+    LOSSY_TEST(!lwrb_init_lossy(&buff, lwrb_data, 48));
+    LOSSY_TEST(lwrb_init_lossy(&buff, lwrb_data, sizeof(lwrb_data)));
+
+    /* Empty buffer */
+    LOSSY_TEST(lwrb_read_lossy(&buff, out, sizeof(out), &lost) == 0 && lost == 0);
+
+    /* Full buffer size is usable */
+    LOSSY_TEST(lwrb_write_lossy(&buff, in, 64) == 64);
+    LOSSY_TEST(lwrb_read_lossy(&buff, out, 10, &lost) == 10 && lost == 0);
+    LOSSY_TEST(memcmp(out, in, 10) == 0);
+
+    /* Overrun reader by 30 bytes, reader resynchronizes to oldest data */
+    LOSSY_TEST(lwrb_write_lossy(&buff, &in[64], 40) == 40);
+    LOSSY_TEST(lwrb_read_lossy(&buff, out, sizeof(out), &lost) == 64 && lost == 30);
+    LOSSY_TEST(memcmp(out, &in[40], 64) == 0);
+    LOSSY_TEST(lwrb_read_lossy(&buff, out, sizeof(out), NULL) == 0);
+
+    /* Write larger than buffer keeps last part only */
+    LOSSY_TEST(lwrb_write_lossy(&buff, &in[104], 96) == 96);
+    LOSSY_TEST(lwrb_read_lossy(&buff, out, sizeof(out), &lost) == 64 && lost == 32);
+    LOSSY_TEST(memcmp(out, &in[136], 64) == 0);
+
+    /* Concurrent writer, every returned byte must be valid and stream position must be exact */
+    lwrb_init_lossy(&buff, lwrb_data, sizeof(lwrb_data));
+    {
+        pthread_t prod;
+        int ok = 1;
+
+        pos = 0;
+        total_lost = 0;
+        producer_done = 0;
+        pthread_create(&prod, NULL, prv_producer_thread, NULL);
+        while (1) {
+            int done = producer_done;
+
+            len = lwrb_read_lossy(&buff, out, sizeof(out), &lost);
+            if (done && len == 0 && lost == 0) {
+                break;
+            }
+            pos += lost;
+            total_lost += lost;
+            for (size_t i = 0; i < len; ++i) {
+                ok &= out[i] == prv_pattern(pos + i);
+            }
+            pos += len;
+        }
+        pthread_join(prod, NULL);
+        LOSSY_TEST(ok);
+        LOSSY_TEST(total_lost < pos);
+        LOSSY_TEST(pos == (STREAM_LEN + 36) / 37 * 37);
+        printf("Lossy: %lu bytes lost of %lu\r\n", (unsigned long)total_lost, (unsigned long)STREAM_LEN);
+    }
+
+    return retval;
+}
@@ -1,5 +1,6 @@
+#include "lwrb/lwrb.h" /* First, it may define feature macros for system headers */
+
 #include <stdio.h>
-#include "lwrb/lwrb.h"
 #include "test.h"
 
 int
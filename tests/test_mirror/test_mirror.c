@@ -0,0 +1,71 @@
+#include <stdio.h>
+#include <string.h>
+#include <unistd.h>
+#include "lwrb/lwrb.h"
+
+lwrb_t buff;
+
+uint8_t tmp[64];
+
+#define MIRROR_TEST(_cond_)                                                                                            \
+    do {                                                                                                               \
+        if (!(_cond_)) {                                                                                               \
+            printf("Test failed on line %u\r\n", (unsigned)__LINE__);                                                  \
+            retval = -1;                                                                                               \
+        }                                                                                                              \
+    } while (0)
+
+int
+test_run(void) {
+    int retval = 0;
+    lwrb_sz_t page_size = (lwrb_sz_t)sysconf(_SC_PAGESIZE);
+    lwrb_sz_t len;
+
+    printf("Init test\r\n");
+    {
+        MIRROR_TEST(lwrb_init_mirror(&buff, page_size + 1) == 0); /* Not multiple of page size */
+        MIRROR_TEST(lwrb_init_mirror(&buff, page_size) == 1);
+        MIRROR_TEST(buff.linear_size == 2 * page_size);
+
+        /* Both halves are the same memory */
+        buff.buff[page_size + 10] = 0x5A;
+        MIRROR_TEST(buff.buff[10] == 0x5A);
+    }
+
+    printf("Linear block across the end test\r\n");
+    {
+        uint8_t* addr;
+
+        /* Move pointers close to the end of the buffer */
+        lwrb_advance(&buff, page_size - 10);
+        lwrb_skip(&buff, page_size - 10);
+
+        /* Complete free memory is one linear block */
+        MIRROR_TEST(lwrb_get_linear_block_write_length(&buff) == lwrb_get_free(&buff));
+        len = lwrb_write(&buff, "0123456789ABCDEFGHIJ", 20);
+        MIRROR_TEST(len == 20);
+        MIRROR_TEST(buff.w_ptr == 10);
+        MIRROR_TEST(memcmp(buff.buff, "ABCDEFGHIJ", 10) == 0);
+
+        /* Complete data is one linear block */
+        MIRROR_TEST(lwrb_get_linear_block_read_length(&buff) == 20);
+        addr = lwrb_get_linear_block_read_address(&buff);
+        MIRROR_TEST(memcmp(addr, "0123456789ABCDEFGHIJ", 20) == 0);
+
+        len = lwrb_peek(&buff, 5, tmp, sizeof(tmp));
+        MIRROR_TEST(len == 15 && memcmp(tmp, "56789ABCDEFGHIJ", 15) == 0);
+        len = lwrb_read(&buff, tmp, sizeof(tmp));
+        MIRROR_TEST(len == 20 && memcmp(tmp, "0123456789ABCDEFGHIJ", 20) == 0);
+        MIRROR_TEST(lwrb_get_full(&buff) == 0);
+    }
+
+    printf("Free test\r\n");
+    {
+        lwrb_free_mirror(&buff);
+        MIRROR_TEST(lwrb_is_ready(&buff) == 0);
+        MIRROR_TEST(buff.linear_size == buff.size);
+    }
+
+    printf("Done!\r\n");
+    return retval;
+}
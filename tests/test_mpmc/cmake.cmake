@@ -0,0 +1,11 @@
+# CMake include file
+
+# Add more sources
+target_sources(${CMAKE_PROJECT_NAME} PRIVATE
+    ${CMAKE_CURRENT_LIST_DIR}/test_mpmc.c
+)
+target_compile_definitions(lwrb PUBLIC LWRB_POW2 LWRB_MULTI_PRODUCER LWRB_MULTI_CONSUMER)
+
+# Test runs several producer and consumer threads
+find_package(Threads REQUIRED)
+target_link_libraries(${CMAKE_PROJECT_NAME} PRIVATE Threads::Threads)
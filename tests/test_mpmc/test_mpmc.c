@@ -0,0 +1,152 @@
+#include <pthread.h>
+#include <sched.h>
+#include <stdatomic.h>
+#include <stdio.h>
+#include <string.h>
+#include "lwrb/lwrb.h"
+
+#define PRODUCER_COUNT      3
+#define CONSUMER_COUNT      3
+#define RECORDS_PER_PRODUCER 20000
+
+/* Record written and read by threads as one unit */
+typedef struct {
+    uint32_t producer;
+    uint32_t seq;
+} record_t;
+
+uint8_t lwrb_data[8 * sizeof(record_t)];
+lwrb_t buff;
+
+uint8_t tmp[8];
+
+/* Number of times each record has been received by any consumer */
+static uint8_t seen[PRODUCER_COUNT][RECORDS_PER_PRODUCER];
+static atomic_uint received;
+static atomic_uint invalid;
+
+#define MPMC_TEST(_cond_)                                                                                              \
+    do {                                                                                                               \
+        if (!(_cond_)) {                                                                                               \
+            printf("Test failed on line %u\r\n", (unsigned)__LINE__);                                                  \
+            retval = -1;                                                                                               \
+        }                                                                                                              \
+    } while (0)
+
+static void*
+producer_thread(void* arg) {
+    record_t rec = {.producer = (uint32_t)(size_t)arg};
+    lwrb_sz_t written;
+
+    for (rec.seq = 0; rec.seq < RECORDS_PER_PRODUCER;) {
+        if (lwrb_write_mp_ex(&buff, &rec, sizeof(rec), &written, LWRB_FLAG_WRITE_ALL)) {
+            ++rec.seq;
+        } else {
+            sched_yield();
+        }
+    }
+    return NULL;
+}
+
+static void*
+consumer_thread(void* arg) {
+    record_t rec;
+    lwrb_sz_t read;
+
+    (void)arg;
+    while (atomic_load(&received) < PRODUCER_COUNT * RECORDS_PER_PRODUCER) {
+        if (lwrb_read_mc_ex(&buff, &rec, sizeof(rec), &read, LWRB_FLAG_READ_ALL)) {
+            if (rec.producer < PRODUCER_COUNT && rec.seq < RECORDS_PER_PRODUCER) {
+                ++seen[rec.producer][rec.seq]; /* Each record is claimed by exactly one consumer */
+            } else {
+                atomic_fetch_add(&invalid, 1);
+            }
+            atomic_fetch_add(&received, 1);
+        } else {
+            sched_yield();
+        }
+    }
+    return NULL;
+}
+
+/**
+ * \brief           Run all producers and consumers through buffer of given size, check every record
+ * \return          `0` on success, `-1` otherwise
+ */
+static int
+run_threads(lwrb_sz_t size) {
+    int retval = 0;
+    pthread_t prod[PRODUCER_COUNT], cons[CONSUMER_COUNT];
+
+    memset(seen, 0x00, sizeof(seen));
+    atomic_store(&received, 0);
+    atomic_store(&invalid, 0);
+    lwrb_init(&buff, lwrb_data, size);
+    for (size_t i = 0; i < CONSUMER_COUNT; ++i) {
+        pthread_create(&cons[i], NULL, consumer_thread, NULL);
+    }
+    for (size_t i = 0; i < PRODUCER_COUNT; ++i) {
+        pthread_create(&prod[i], NULL, producer_thread, (void*)i);
+    }
+    for (size_t i = 0; i < PRODUCER_COUNT; ++i) {
+        pthread_join(prod[i], NULL);
+    }
+    for (size_t i = 0; i < CONSUMER_COUNT; ++i) {
+        pthread_join(cons[i], NULL);
+    }
+
+    /* Every record received exactly once and never split */
+    MPMC_TEST(atomic_load(&invalid) == 0);
+    for (size_t p = 0; p < PRODUCER_COUNT; ++p) {
+        for (size_t i = 0; i < RECORDS_PER_PRODUCER; ++i) {
+            if (seen[p][i] != 1) {
+                MPMC_TEST(0);
+                p = PRODUCER_COUNT;
+                break;
+            }
+        }
+    }
+    MPMC_TEST(lwrb_get_full(&buff) == 0);
+    MPMC_TEST(buff.w_ptr == buff.w_rsv && buff.r_ptr == buff.r_rsv);
+    return retval;
+}
+
+int
+test_run(void) {
+    int retval = 0;
+    lwrb_sz_t len;
+
+    printf("Single thread test\r\n");
+    {
+        MPMC_TEST(!lwrb_init(&buff, lwrb_data, 9));
+        lwrb_init(&buff, lwrb_data, 8);
+        MPMC_TEST(lwrb_read_mc(&buff, tmp, 1) == 0);
+        MPMC_TEST(lwrb_write_mp(&buff, "abcdef", 6) == 6);
+        MPMC_TEST(lwrb_read_mc_ex(&buff, tmp, 7, &len, LWRB_FLAG_READ_ALL) == 0);
+        MPMC_TEST(lwrb_read_mc(&buff, tmp, 4) == 4 && memcmp(tmp, "abcd", 4) == 0);
+        MPMC_TEST(buff.r_ptr == 4 && buff.r_rsv == 4);
+
+        /* Wrap over the end of the buffer */
+        MPMC_TEST(lwrb_write(&buff, "ghijk", 5) == 5);
+        MPMC_TEST(lwrb_read_mc(&buff, tmp, 8) == 7 && memcmp(tmp, "efghijk", 7) == 0);
+        MPMC_TEST(buff.r_ptr == 11 && buff.r_rsv == 11);
+
+        /* Single-consumer functions keep reservation pointer in sync */
+        MPMC_TEST(lwrb_write(&buff, "lmn", 3) == 3);
+        MPMC_TEST(lwrb_read(&buff, tmp, 1) == 1);
+        MPMC_TEST(lwrb_skip(&buff, 1) == 1);
+        MPMC_TEST(buff.r_ptr == 13 && buff.r_rsv == 13);
+        MPMC_TEST(lwrb_read_mc(&buff, tmp, 8) == 1 && tmp[0] == 'n');
+        lwrb_reset(&buff);
+        MPMC_TEST(buff.r_rsv == 0);
+    }
+
+    printf("Multi producer, multi consumer test\r\n");
+    MPMC_TEST(run_threads(sizeof(lwrb_data)) == 0);
+
+    printf("Multi producer, multi consumer stress test, buffer of 2 records\r\n");
+    MPMC_TEST(run_threads(2 * sizeof(record_t)) == 0);
+
+    printf("Done!\r\n");
+    return retval;
+}
@@ -0,0 +1,144 @@
+#include <pthread.h>
+#include <sched.h>
+#include <stdio.h>
+#include <string.h>
+#include "lwrb/lwrb.h"
+
+#define PRODUCER_COUNT      4
+#define RECORDS_PER_PRODUCER 20000
+
+/* Record written by producers as one unit */
+typedef struct {
+    uint32_t producer;
+    uint32_t seq;
+} record_t;
+
+uint8_t lwrb_data[8 * sizeof(record_t)];
+lwrb_t buff;
+
+uint8_t tmp[8];
+
+#define MPSC_TEST(_cond_)                                                                                              \
+    do {                                                                                                               \
+        if (!(_cond_)) {                                                                                               \
+            printf("Test failed on line %u\r\n", (unsigned)__LINE__);                                                  \
+            retval = -1;                                                                                               \
+        }                                                                                                              \
+    } while (0)
+
+static void*
+producer_thread(void* arg) {
+    record_t rec = {.producer = (uint32_t)(size_t)arg};
+    lwrb_sz_t written;
+
+    for (rec.seq = 0; rec.seq < RECORDS_PER_PRODUCER;) {
+        if (lwrb_write_mp_ex(&buff, &rec, sizeof(rec), &written, LWRB_FLAG_WRITE_ALL)) {
+            ++rec.seq;
+        } else {
+            sched_yield();
+        }
+    }
+    return NULL;
+}
+
+int
+test_run(void) {
+    int retval = 0;
+    lwrb_sz_t len;
+
+    printf("Single thread test\r\n");
+    {
+        MPSC_TEST(!lwrb_init(&buff, lwrb_data, 9));
+        lwrb_init(&buff, lwrb_data, 8);
+        len = lwrb_write_mp(&buff, "abcdef", 6);
+        MPSC_TEST(len == 6);
+        MPSC_TEST(buff.w_ptr == 6 && buff.w_rsv == 6);
+
+        /* Not enough memory for all */
+        MPSC_TEST(lwrb_write_mp_ex(&buff, "ghij", 4, &len, LWRB_FLAG_WRITE_ALL) == 0);
+        len = lwrb_write_mp(&buff, "ghij", 4);
+        MPSC_TEST(len == 2);
+        MPSC_TEST(lwrb_write_mp(&buff, "k", 1) == 0);
+
+        /* Wrap over the end of the buffer */
+        MPSC_TEST(lwrb_read(&buff, tmp, 5) == 5 && memcmp(tmp, "abcde", 5) == 0);
+        len = lwrb_write_mp(&buff, "klmno", 5);
+        MPSC_TEST(len == 5);
+        MPSC_TEST(buff.w_ptr == 13 && buff.w_rsv == 13);
+
+        /* Single-producer functions keep reservation pointer in sync */
+        MPSC_TEST(lwrb_read(&buff, tmp, 8) == 8 && memcmp(tmp, "fghklmno", 8) == 0);
+        MPSC_TEST(lwrb_write(&buff, "pq", 2) == 2);
+        MPSC_TEST(lwrb_advance(&buff, 1) == 1);
+        MPSC_TEST(buff.w_ptr == 16 && buff.w_rsv == 16);
+        MPSC_TEST(lwrb_write_mp(&buff, "rs", 2) == 2);
+        MPSC_TEST(lwrb_get_full(&buff) == 5);
+        lwrb_reset(&buff);
+        MPSC_TEST(buff.w_rsv == 0);
+    }
+
+    printf("Multi producer test\r\n");
+    {
+        pthread_t threads[PRODUCER_COUNT];
+        uint32_t next_seq[PRODUCER_COUNT] = {0};
+        uint32_t received = 0;
+        record_t rec;
+
+        lwrb_init(&buff, lwrb_data, sizeof(lwrb_data));
+        for (size_t i = 0; i < PRODUCER_COUNT; ++i) {
+            pthread_create(&threads[i], NULL, producer_thread, (void*)i);
+        }
+
+        /* Records must never be split and must keep order of each producer */
+        while (received < PRODUCER_COUNT * RECORDS_PER_PRODUCER) {
+            if (lwrb_read_ex(&buff, &rec, sizeof(rec), &len, LWRB_FLAG_READ_ALL)) {
+                if (rec.producer >= PRODUCER_COUNT || rec.seq != next_seq[rec.producer]) {
+                    MPSC_TEST(0);
+                    break;
+                }
+                ++next_seq[rec.producer];
+                ++received;
+            } else {
+                sched_yield();
+            }
+        }
+        for (size_t i = 0; i < PRODUCER_COUNT; ++i) {
+            pthread_join(threads[i], NULL);
+        }
+        MPSC_TEST(lwrb_get_full(&buff) == 0);
+        MPSC_TEST(buff.w_ptr == buff.w_rsv);
+    }
+
+    printf("Multi producer stress test, buffer of 2 records\r\n");
+    {
+        pthread_t threads[PRODUCER_COUNT];
+        uint32_t next_seq[PRODUCER_COUNT] = {0};
+        uint32_t received = 0;
+        record_t rec;
+
+        /* Many buffer cycles per record, stale reservation would overwrite unread record */
+        lwrb_init(&buff, lwrb_data, 2 * sizeof(record_t));
+        for (size_t i = 0; i < PRODUCER_COUNT; ++i) {
+            pthread_create(&threads[i], NULL, producer_thread, (void*)i);
+        }
+        while (received < PRODUCER_COUNT * RECORDS_PER_PRODUCER) {
+            if (lwrb_read_ex(&buff, &rec, sizeof(rec), &len, LWRB_FLAG_READ_ALL)) {
+                if (rec.producer >= PRODUCER_COUNT || rec.seq != next_seq[rec.producer]) {
+                    MPSC_TEST(0);
+                    break;
+                }
+                ++next_seq[rec.producer];
+                ++received;
+            } else {
+                sched_yield();
+            }
+        }
+        for (size_t i = 0; i < PRODUCER_COUNT; ++i) {
+            pthread_join(threads[i], NULL);
+        }
+        MPSC_TEST(lwrb_get_full(&buff) == 0);
+    }
+
+    printf("Done!\r\n");
+    return retval;
+}
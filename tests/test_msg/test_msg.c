@@ -0,0 +1,94 @@
+#include <stdio.h>
+#include <string.h>
+#include "lwrb/lwrb.h"
+
+/* Header is sizeof(lwrb_sz_t) bytes, buffer fits 2 short records */
+#define HDR_SIZE sizeof(lwrb_sz_t)
+uint8_t lwrb_data[2 * (HDR_SIZE + 5) + 1];
+lwrb_t buff;
+
+#define MSG_TEST(_cond_)                                                                                               \
+    do {                                                                                                               \
+        if (!(_cond_)) {                                                                                               \
+            printf("Test failed on line %u\r\n", (unsigned)__LINE__);                                                  \
+            retval = -1;                                                                                               \
+        }                                                                                                              \
+    } while (0)
+
+int
+test_run(void) {
+    int retval = 0;
+    uint8_t out[16];
+    lwrb_sz_t len, lens[4];
+
+    lwrb_init(&buff, lwrb_data, sizeof(lwrb_data));
+
+    printf("Write/read test\r\n");
+    {
+        MSG_TEST(lwrb_msg_write(&buff, "hello", 5) == 1);
+        MSG_TEST(lwrb_msg_write(&buff, "abc", 3) == 1);
+        MSG_TEST(lwrb_get_full(&buff) == 2 * HDR_SIZE + 8);
+
+        /* No memory for complete record, nothing is written */
+        MSG_TEST(lwrb_msg_write(&buff, "xyz", 3) == 0);
+        MSG_TEST(lwrb_get_full(&buff) == 2 * HDR_SIZE + 8);
+        MSG_TEST(lwrb_msg_write(&buff, "x", 0) == 0);
+
+        MSG_TEST(lwrb_msg_peek_len(&buff, &len) == 1 && len == 5);
+        MSG_TEST(lwrb_msg_read(&buff, out, 4) == 0); /* Does not fit, stays in buffer */
+        MSG_TEST(lwrb_msg_read(&buff, out, sizeof(out)) == 5 && memcmp(out, "hello", 5) == 0);
+        MSG_TEST(lwrb_msg_skip(&buff) == 3);
+        MSG_TEST(lwrb_get_full(&buff) == 0);
+        MSG_TEST(lwrb_msg_peek_len(&buff, &len) == 0);
+        MSG_TEST(lwrb_msg_read(&buff, out, sizeof(out)) == 0);
+        MSG_TEST(lwrb_msg_skip(&buff) == 0);
+    }
+
+    printf("Wrap test\r\n");
+    {
+        /* Header and payload both cross the end of the buffer */
+        for (size_t i = 0; i < sizeof(lwrb_data); ++i) {
+            lwrb_reset(&buff);
+            lwrb_advance(&buff, i);
+            lwrb_skip(&buff, i);
+            MSG_TEST(lwrb_msg_write(&buff, "12345", 5) == 1);
+            MSG_TEST(lwrb_msg_write(&buff, "678", 3) == 1);
+            MSG_TEST(lwrb_msg_read(&buff, out, sizeof(out)) == 5 && memcmp(out, "12345", 5) == 0);
+            MSG_TEST(lwrb_msg_read(&buff, out, sizeof(out)) == 3 && memcmp(out, "678", 3) == 0);
+        }
+    }
+
+    printf("Partial record test\r\n");
+    {
+        /* Header only, as written by other means, is not a complete record */
+        lwrb_reset(&buff);
+        len = 4;
+        lwrb_write(&buff, &len, sizeof(len));
+        lwrb_write(&buff, "ab", 2);
+        MSG_TEST(lwrb_msg_peek_len(&buff, &len) == 0);
+        MSG_TEST(lwrb_msg_read(&buff, out, sizeof(out)) == 0);
+        lwrb_write(&buff, "cd", 2);
+        MSG_TEST(lwrb_msg_read(&buff, out, sizeof(out)) == 4 && memcmp(out, "abcd", 4) == 0);
+    }
+
+    printf("Batch read test\r\n");
+    {
+        lwrb_reset(&buff);
+        lwrb_msg_write(&buff, "12345", 5);
+        lwrb_msg_write(&buff, "67", 2);
+        MSG_TEST(lwrb_msg_read_batch(&buff, out, sizeof(out), lens, 4) == 2);
+        MSG_TEST(lens[0] == 5 && lens[1] == 2 && memcmp(out, "1234567", 7) == 0);
+        MSG_TEST(lwrb_get_full(&buff) == 0);
+
+        /* Limited by number of records and by output memory */
+        lwrb_msg_write(&buff, "12345", 5);
+        lwrb_msg_write(&buff, "67", 2);
+        MSG_TEST(lwrb_msg_read_batch(&buff, out, sizeof(out), lens, 1) == 1 && lens[0] == 5);
+        MSG_TEST(lwrb_msg_read_batch(&buff, out, 1, lens, 4) == 0);
+        MSG_TEST(lwrb_msg_read_batch(&buff, out, 2, lens, 4) == 1 && lens[0] == 2 && memcmp(out, "67", 2) == 0);
+        MSG_TEST(lwrb_msg_read_batch(&buff, out, sizeof(out), lens, 4) == 0);
+    }
+
+    printf("Done\r\n");
+    return retval;
+}
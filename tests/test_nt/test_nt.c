@@ -0,0 +1,64 @@
+#include <stdio.h>
+#include <string.h>
+#include "lwrb/lwrb.h"
+
+uint8_t lwrb_data[1000 + 1], lossy_data[256];
+uint8_t src[1000 + 16], dst[1000];
+lwrb_t buff;
+
+#define NT_TEST(_cond_)                                                                                                \
+    do {                                                                                                               \
+        if (!(_cond_)) {                                                                                               \
+            printf("Test failed on line %u\r\n", (unsigned)__LINE__);                                                  \
+            retval = -1;                                                                                               \
+        }                                                                                                              \
+    } while (0)
+
+int
+test_run(void) {
+    int retval = 0;
+    static const lwrb_sz_t lens[] = {1, 15, 63, 64, 65, 200, 511, 1000};
+
+    for (size_t i = 0; i < sizeof(src); ++i) {
+        src[i] = (uint8_t)(i * 7 + 3);
+    }
+
+    NT_TEST(!lwrb_set_nt_threshold(&buff, 1, 1));
+    lwrb_init(&buff, lwrb_data, sizeof(lwrb_data));
+    NT_TEST(buff.nt_w_threshold == 0 && buff.nt_r_threshold == 0);
+    NT_TEST(lwrb_set_nt_threshold(&buff, 64, 64));
+
+    /* Every length at every start offset, including wrap-around and unaligned memory */
+    for (size_t l = 0; l < sizeof(lens) / sizeof(lens[0]); ++l) {
+        for (lwrb_sz_t offset = 0; offset < 70; ++offset) {
+            lwrb_reset(&buff);
+            lwrb_advance(&buff, sizeof(lwrb_data) - 1 - offset);
+            lwrb_skip(&buff, sizeof(lwrb_data) - 1 - offset);
+            lwrb_advance(&buff, 1000 - lens[l]);
+            lwrb_skip(&buff, 1000 - lens[l]);
+
+            memset(dst, 0x00, sizeof(dst));
+            NT_TEST(lwrb_write(&buff, &src[offset % 16], lens[l]) == lens[l]);
+            NT_TEST(lwrb_read(&buff, dst, sizeof(dst)) == lens[l]);
+            NT_TEST(memcmp(dst, &src[offset % 16], lens[l]) == 0);
+        }
+    }
+
+    /* Lossy write with streaming stores, wrapped and overwriting */
+    NT_TEST(lwrb_init_lossy(&buff, lossy_data, sizeof(lossy_data)));
+    NT_TEST(lwrb_set_nt_threshold(&buff, 64, 64));
+    for (size_t i = 0; i < 5; ++i) {
+        lwrb_sz_t lost = 0;
+
+        NT_TEST(lwrb_write_lossy(&buff, &src[i], 200) == 200);
+        NT_TEST(lwrb_write_lossy(&buff, &src[i + 200], 100) == 100);
+        NT_TEST(lwrb_read_lossy(&buff, dst, sizeof(dst), &lost) == 256 && lost == 44);
+        NT_TEST(memcmp(dst, &src[i + 44], 256) == 0);
+    }
+
+    /* Regular copy when disabled */
+    NT_TEST(lwrb_set_nt_threshold(&buff, 0, 0));
+    NT_TEST(lwrb_write(&buff, src, 100) == 100);
+    NT_TEST(lwrb_read(&buff, dst, sizeof(dst)) == 100 && memcmp(dst, src, 100) == 0);
+    return retval;
+}
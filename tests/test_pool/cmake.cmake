@@ -0,0 +1,7 @@
+# CMake include file
+
+# Add more sources
+target_sources(${CMAKE_PROJECT_NAME} PRIVATE
+    ${CMAKE_CURRENT_LIST_DIR}/test_pool.c
+)
+target_compile_definitions(lwrb PUBLIC LWRB_POOL)
@@ -0,0 +1,65 @@
+#include <stdio.h>
+#include <string.h>
+#include "lwrb/lwrb.h"
+
+static const lwrb_sz_t sizes[] = {16 + 1, 64 + 1};
+uint8_t arena[4 * 1024], arena2[1024];
+uint8_t other_data[16 + 1];
+lwrb_pool_t pool;
+lwrb_t other;
+
+#define POOL_TEST(_cond_)                                                                                              \
+    do {                                                                                                               \
+        if (!(_cond_)) {                                                                                               \
+            printf("Test failed on line %u\r\n", (unsigned)__LINE__);                                                  \
+            retval = -1;                                                                                               \
+        }                                                                                                              \
+    } while (0)
+
+int
+test_run(void) {
+    int retval = 0;
+    uint8_t tmp[16];
+    lwrb_t *a, *b, *c, *d;
+    static const lwrb_sz_t bad_sizes[] = {64 + 1, 16 + 1};
+
+    POOL_TEST(!lwrb_pool_init(&pool, arena, sizeof(arena), bad_sizes, 2));
+    POOL_TEST(lwrb_pool_init(&pool, arena, sizeof(arena), sizes, 2));
+
+    /* Smallest fitting class is used */
+    a = lwrb_pool_alloc(&pool, 10);
+    b = lwrb_pool_alloc(&pool, 18);
+    POOL_TEST(a != NULL && b != NULL);
+    POOL_TEST(lwrb_pool_alloc(&pool, 100) == NULL);
+    POOL_TEST(((uintptr_t)a % LWRB_POOL_ALIGN) == 0 && ((uintptr_t)b % LWRB_POOL_ALIGN) == 0);
+    POOL_TEST(((uintptr_t)a % _Alignof(lwrb_t)) == 0 && ((uintptr_t)b % _Alignof(lwrb_t)) == 0);
+    POOL_TEST(a->size == 17 && b->size == 65);
+    POOL_TEST(lwrb_get_free(a) == 16 && lwrb_get_free(b) == 64);
+
+    /* Buffers are independent */
+    POOL_TEST(lwrb_write(a, "abcdefghijklmnop", 16) == 16);
+    POOL_TEST(lwrb_write(b, "0123456789", 10) == 10);
+    POOL_TEST(lwrb_read(a, tmp, sizeof(tmp)) == 16 && memcmp(tmp, "abcdefghijklmnop", 16) == 0);
+    POOL_TEST(lwrb_read(b, tmp, sizeof(tmp)) == 10 && memcmp(tmp, "0123456789", 10) == 0);
+
+    /* Released slot is reused by its class, reinitialized */
+    lwrb_write(a, "xyz", 3);
+    POOL_TEST(lwrb_pool_free(&pool, a));
+    POOL_TEST(!lwrb_pool_free(&pool, a));
+    c = lwrb_pool_alloc(&pool, 16);
+    POOL_TEST(c == a);
+    POOL_TEST(lwrb_get_full(c) == 0 && lwrb_get_free(c) == 16);
+
+    /* Exhaust the arena, then continue in another one */
+    while ((d = lwrb_pool_alloc(&pool, 64)) != NULL) {}
+    POOL_TEST(lwrb_pool_add_arena(&pool, arena2, sizeof(arena2)));
+    d = lwrb_pool_alloc(&pool, 64);
+    POOL_TEST(d != NULL && (uint8_t*)d >= arena2 && (uint8_t*)d < arena2 + sizeof(arena2));
+    POOL_TEST(lwrb_pool_free(&pool, b));
+    POOL_TEST(lwrb_pool_alloc(&pool, 64) == b);
+
+    /* Buffer not from the pool */
+    lwrb_init(&other, other_data, sizeof(other_data));
+    POOL_TEST(!lwrb_pool_free(&pool, &other));
+    return retval;
+}
@@ -0,0 +1,7 @@
+# CMake include file
+
+# Pool test, with buffer handle aligned to cache line larger than pool slot alignment
+target_sources(${CMAKE_PROJECT_NAME} PRIVATE
+    ${CMAKE_CURRENT_LIST_DIR}/../test_pool/test_pool.c
+)
+target_compile_definitions(lwrb PUBLIC LWRB_POOL LWRB_CACHELINE_ISOLATE LWRB_CACHELINE_SIZE=128)
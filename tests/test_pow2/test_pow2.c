@@ -0,0 +1,123 @@
+#include <stdio.h>
+#include <string.h>
+#include "lwrb/lwrb.h"
+
+/* Power of 2 buffer, full size is usable */
+uint8_t lwrb_data[8];
+lwrb_t buff;
+
+uint8_t tmp[8];
+
+#define POW2_TEST(_cond_)                                                                                              \
+    do {                                                                                                               \
+        if (!(_cond_)) {                                                                                               \
+            printf("Test failed on line %u\r\n", (unsigned)__LINE__);                                                  \
+            retval = -1;                                                                                               \
+        }                                                                                                              \
+    } while (0)
+
+int
+test_run(void) {
+    int retval = 0;
+    lwrb_sz_t len;
+
+    printf("Init test\r\n");
+    {
+        uint8_t data[6];
+
+        POW2_TEST(lwrb_init(&buff, data, sizeof(data)) == 0); /* Not power of 2 */
+        POW2_TEST(lwrb_init(&buff, lwrb_data, sizeof(lwrb_data)) == 1);
+        POW2_TEST(lwrb_get_free(&buff) == 8);
+        POW2_TEST(lwrb_get_full(&buff) == 0);
+    }
+
+    printf("Read/Write test\r\n");
+    {
+        lwrb_reset(&buff);
+        len = lwrb_write(&buff, "01234567", 8); /* Complete buffer is usable */
+        POW2_TEST(len == 8);
+        POW2_TEST(lwrb_get_free(&buff) == 0);
+        POW2_TEST(lwrb_get_full(&buff) == 8);
+        POW2_TEST(lwrb_write(&buff, "8", 1) == 0);
+        POW2_TEST(lwrb_get_linear_block_write_length(&buff) == 0);
+
+        len = lwrb_read(&buff, tmp, 3);
+        POW2_TEST(len == 3 && memcmp(tmp, "012", 3) == 0);
+        len = lwrb_write(&buff, "ABCD", 4); /* Only 3 fit, wrap to the beginning */
+        POW2_TEST(len == 3);
+
+        /* Pointers are free running, not wrapped to buffer size */
+        POW2_TEST(buff.w_ptr == 11 && buff.r_ptr == 3);
+        POW2_TEST(lwrb_get_full(&buff) == 8);
+        POW2_TEST(lwrb_get_linear_block_read_length(&buff) == 5);
+        POW2_TEST(lwrb_get_linear_block_read_address(&buff) == &lwrb_data[3]);
+
+        len = lwrb_peek(&buff, 4, tmp, 8);
+        POW2_TEST(len == 4 && memcmp(tmp, "7ABC", 4) == 0);
+
+        len = lwrb_read(&buff, tmp, sizeof(tmp));
+        POW2_TEST(len == 8 && memcmp(tmp, "34567ABC", 8) == 0);
+        POW2_TEST(lwrb_get_full(&buff) == 0);
+        POW2_TEST(lwrb_get_free(&buff) == 8);
+        POW2_TEST(lwrb_get_linear_block_write_length(&buff) == 5);
+        POW2_TEST(lwrb_get_linear_block_write_address(&buff) == &lwrb_data[3]);
+    }
+
+    printf("Skip/Advance test\r\n");
+    {
+        lwrb_reset(&buff);
+        lwrb_advance(&buff, 6);
+        lwrb_skip(&buff, 6);
+        POW2_TEST(lwrb_advance(&buff, 10) == 8);
+        POW2_TEST(lwrb_get_full(&buff) == 8);
+        POW2_TEST(lwrb_get_linear_block_read_length(&buff) == 2);
+        POW2_TEST(lwrb_skip(&buff, 2) == 2);
+        POW2_TEST(lwrb_get_linear_block_read_length(&buff) == 6);
+        POW2_TEST(lwrb_get_linear_block_write_length(&buff) == 2);
+        POW2_TEST(lwrb_skip(&buff, 10) == 6);
+        POW2_TEST(buff.w_ptr == buff.r_ptr && buff.r_ptr == 14);
+    }
+
+    printf("Pointer overflow test\r\n");
+    {
+        /* Pointers close to the type limit must keep working after they overflow */
+        lwrb_reset(&buff);
+        buff.w_ptr = (lwrb_sz_t)-3;
+        buff.r_ptr = (lwrb_sz_t)-3;
+        len = lwrb_write(&buff, "abcdef", 6);
+        POW2_TEST(len == 6);
+        POW2_TEST(buff.w_ptr == 3);
+        POW2_TEST(lwrb_get_full(&buff) == 6);
+        POW2_TEST(lwrb_get_free(&buff) == 2);
+        len = lwrb_read(&buff, tmp, sizeof(tmp));
+        POW2_TEST(len == 6 && memcmp(tmp, "abcdef", 6) == 0);
+    }
+
+    printf("Find test\r\n");
+    {
+        lwrb_sz_t found_idx;
+
+        lwrb_reset(&buff);
+        lwrb_advance(&buff, 5);
+        lwrb_skip(&buff, 5);
+        lwrb_write(&buff, "12345678", 8);
+        POW2_TEST(lwrb_find(&buff, "345", 3, 0, &found_idx) == 1 && found_idx == 2);
+        POW2_TEST(lwrb_find(&buff, "678", 3, 0, &found_idx) == 1 && found_idx == 5);
+        POW2_TEST(lwrb_find(&buff, "123", 3, 1, &found_idx) == 0);
+    }
+
+    printf("Overwrite test\r\n");
+    {
+        lwrb_reset(&buff);
+        lwrb_write(&buff, "abcdefgh", 8);
+        lwrb_overwrite(&buff, "01", 2);
+        len = lwrb_peek(&buff, 0, tmp, sizeof(tmp));
+        POW2_TEST(len == 8 && memcmp(tmp, "cdefgh01", 8) == 0);
+        lwrb_overwrite(&buff, "lwrb_new_test_structure", 23);
+        len = lwrb_peek(&buff, 0, tmp, sizeof(tmp));
+        POW2_TEST(len == 8 && memcmp(tmp, "tructure", 8) == 0);
+    }
+
+    printf("Done!\r\n");
+    return retval;
+}
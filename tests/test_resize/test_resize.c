@@ -0,0 +1,69 @@
+#include <stdio.h>
+#include <string.h>
+#include "lwrb/lwrb.h"
+
+uint8_t lwrb_data[8 + 1], lwrb_data_new[16 + 1], lwrb_data_small[4 + 1];
+lwrb_t buff;
+
+#define RESIZE_TEST(_cond_)                                                                                            \
+    do {                                                                                                               \
+        if (!(_cond_)) {                                                                                               \
+            printf("Test failed on line %u\r\n", (unsigned)__LINE__);                                                  \
+            retval = -1;                                                                                               \
+        }                                                                                                              \
+    } while (0)
+
+int
+test_run(void) {
+    int retval = 0;
+    uint8_t tmp[32];
+    void* old = NULL;
+
+    /* Grow buffer with wrapped content to user memory */
+    lwrb_init(&buff, lwrb_data, sizeof(lwrb_data));
+    lwrb_write(&buff, "abcdef", 6);
+    lwrb_skip(&buff, 4);
+    lwrb_write(&buff, "ghijkl", 6);
+    RESIZE_TEST(lwrb_get_full(&buff) == 8);
+    RESIZE_TEST(!lwrb_resize(&buff, lwrb_data_small, sizeof(lwrb_data_small), &old));
+    RESIZE_TEST(lwrb_resize(&buff, lwrb_data_new, sizeof(lwrb_data_new), &old));
+    RESIZE_TEST(old == lwrb_data);
+    RESIZE_TEST(lwrb_get_full(&buff) == 8);
+    RESIZE_TEST(lwrb_get_free(&buff) == 8);
+    RESIZE_TEST(lwrb_get_linear_block_read_length(&buff) == 8);
+    RESIZE_TEST(lwrb_write(&buff, "mnopqrst", 8) == 8);
+    RESIZE_TEST(lwrb_read(&buff, tmp, sizeof(tmp)) == 16 && memcmp(tmp, "efghijklmnopqrst", 16) == 0);
+
+    /* Shrink back */
+    lwrb_write(&buff, "xyz", 3);
+    RESIZE_TEST(lwrb_resize(&buff, lwrb_data_small, sizeof(lwrb_data_small), NULL));
+    RESIZE_TEST(lwrb_read(&buff, tmp, sizeof(tmp)) == 3 && memcmp(tmp, "xyz", 3) == 0);
+
+    /* Application memory is never reallocated or released by the library */
+    lwrb_write(&buff, "abc", 3);
+    RESIZE_TEST(!lwrb_resize_alloc(&buff, 64));
+    RESIZE_TEST(lwrb_resize_auto(&buff, 2, 64) == 0);
+    RESIZE_TEST(buff.buff == lwrb_data_small && lwrb_get_full(&buff) == 3);
+
+    /* Allocated memory and adaptive size */
+    RESIZE_TEST(lwrb_init_alloc(&buff, 65));
+    RESIZE_TEST(lwrb_write(&buff, tmp, 50) == 50);
+    RESIZE_TEST(lwrb_resize_auto(&buff, 17, 257) == 130);
+    RESIZE_TEST(lwrb_get_full(&buff) == 50);
+    RESIZE_TEST(lwrb_skip(&buff, 40) == 40);
+    RESIZE_TEST(lwrb_resize_auto(&buff, 17, 257) == 130); /* Peak restarted at 50 bytes */
+    RESIZE_TEST(lwrb_resize_auto(&buff, 17, 257) == 65);
+    RESIZE_TEST(lwrb_resize_auto(&buff, 17, 257) == 32); /* 10 bytes of 64 */
+    RESIZE_TEST(lwrb_skip(&buff, 10) == 10);
+    RESIZE_TEST(lwrb_resize_auto(&buff, 17, 257) == 32); /* Minimal size reached */
+    RESIZE_TEST(lwrb_write(&buff, tmp, 31) == 31);
+    RESIZE_TEST(lwrb_resize_auto(&buff, 17, 63) == 32); /* Maximal size reached */
+    RESIZE_TEST(lwrb_resize_auto(&buff, 17, 257) == 64);
+    RESIZE_TEST(lwrb_get_full(&buff) == 31);
+    RESIZE_TEST(!lwrb_resize_alloc(&buff, (lwrb_sz_t)-1)); /* Allocation fails, buffer unchanged */
+    RESIZE_TEST(lwrb_get_full(&buff) == 31 && buff.size == 64);
+    lwrb_free_alloc(&buff);
+    RESIZE_TEST(!lwrb_is_ready(&buff));
+
+    return retval;
+}
@@ -0,0 +1,11 @@
+# CMake include file
+
+# Add more sources
+target_sources(${CMAKE_PROJECT_NAME} PRIVATE
+    ${CMAKE_CURRENT_LIST_DIR}/test_seg.c
+)
+target_compile_definitions(lwrb PUBLIC LWRB_SEG)
+
+# Test runs producer and consumer in different threads
+find_package(Threads REQUIRED)
+target_link_libraries(${CMAKE_PROJECT_NAME} PRIVATE Threads::Threads)
@@ -0,0 +1,172 @@
+#include <pthread.h>
+#include <sched.h>
+#include <stdio.h>
+#include <string.h>
+#include "lwrb/lwrb.h"
+
+#define SEG_TRANSFER_BYTES 1000000
+
+void* pool_mem[4 * 3]; /* 4 chunks of 16 bytes on 64-bit platform */
+lwrb_seg_pool_t pool;
+lwrb_seg_t a, b;
+
+#define SEG_TEST(_cond_)                                                                                               \
+    do {                                                                                                               \
+        if (!(_cond_)) {                                                                                               \
+            printf("Test failed on line %u\r\n", (unsigned)__LINE__);                                                  \
+            retval = -1;                                                                                               \
+        }                                                                                                              \
+    } while (0)
+
+/* Varying transfer length, limited to available space and remaining bytes */
+static lwrb_sz_t
+transfer_len(uint32_t sent, lwrb_sz_t max) {
+    lwrb_sz_t len = 1 + sent % 23;
+
+    len = len < max ? len : max;
+    return len < SEG_TRANSFER_BYTES - sent ? len : SEG_TRANSFER_BYTES - sent;
+}
+
+static void*
+producer_thread(void* arg) {
+    uint8_t data[24];
+    uint32_t sent = 0;
+
+    (void)arg;
+    while (sent < SEG_TRANSFER_BYTES) {
+        lwrb_sz_t len;
+
+        if ((sent & 0x01) == 0) {
+            /* Copy write */
+            len = transfer_len(sent, sizeof(data));
+            for (lwrb_sz_t i = 0; i < len; ++i) {
+                data[i] = (uint8_t)((sent + i) * 7);
+            }
+            len = lwrb_seg_write(&a, data, len);
+        } else {
+            /* Zero-copy write, as with DMA */
+            uint8_t* addr;
+
+            lwrb_seg_reserve(&a);
+            len = transfer_len(sent, lwrb_seg_get_linear_block_write_length(&a));
+            addr = lwrb_seg_get_linear_block_write_address(&a);
+            for (lwrb_sz_t i = 0; i < len; ++i) {
+                addr[i] = (uint8_t)((sent + i) * 7);
+            }
+            len = lwrb_seg_advance(&a, len);
+        }
+        if (len == 0) {
+            sched_yield();
+        }
+        sent += len;
+    }
+    return NULL;
+}
+
+int
+test_run(void) {
+    int retval = 0;
+    uint8_t tmp[64];
+    size_t chunks;
+    uint8_t* addr;
+
+    SEG_TEST(lwrb_seg_pool_init(&pool, pool_mem, sizeof(pool_mem), 16));
+    chunks = lwrb_seg_pool_get_free(&pool);
+    SEG_TEST(chunks >= 4);
+    SEG_TEST(lwrb_seg_init(&a, &pool, 0));
+    SEG_TEST(lwrb_seg_init(&b, &pool, 20));
+
+    /* Empty buffer holds no chunk */
+    SEG_TEST(lwrb_seg_get_full(&a) == 0);
+    SEG_TEST(lwrb_seg_get_free(&a) == chunks * 16);
+    SEG_TEST(lwrb_seg_get_free(&b) == 20);
+
+    /* Write across chunk boundaries, pool is shared */
+    SEG_TEST(lwrb_seg_write(&a, "abcdefghijklmnopqrstuvwxyz", 26) == 26);
+    SEG_TEST(lwrb_seg_pool_get_free(&pool) == chunks - 2);
+    SEG_TEST(lwrb_seg_get_free(&a) == 6 + (chunks - 2) * 16);
+    SEG_TEST(lwrb_seg_write(&b, "0123456789012345678901234", 25) == 20);
+    SEG_TEST(lwrb_seg_get_free(&b) == 0);
+
+    /* Peek across chunks, linear block ends at chunk boundary */
+    SEG_TEST(lwrb_seg_peek(&a, 14, tmp, 4) == 4 && memcmp(tmp, "opqr", 4) == 0);
+    SEG_TEST(lwrb_seg_get_linear_block_read_length(&a) == 16);
+    SEG_TEST(memcmp(lwrb_seg_get_linear_block_read_address(&a), "abcdefghijklmnop", 16) == 0);
+
+    /* Consumed chunks are returned to the pool by producer, tail chunk is kept */
+    SEG_TEST(lwrb_seg_read(&a, tmp, 10) == 10 && memcmp(tmp, "abcdefghij", 10) == 0);
+    SEG_TEST(lwrb_seg_get_linear_block_read_length(&a) == 6);
+    SEG_TEST(lwrb_seg_skip(&a, 6) == 6);
+    SEG_TEST(lwrb_seg_get_linear_block_read_length(&a) == 10);
+    SEG_TEST(lwrb_seg_read(&a, tmp, sizeof(tmp)) == 10 && memcmp(tmp, "qrstuvwxyz", 10) == 0);
+    SEG_TEST(lwrb_seg_get_full(&a) == 0);
+    SEG_TEST(lwrb_seg_pool_get_free(&pool) == chunks - 4);
+    SEG_TEST(lwrb_seg_get_free(&a) == 6 + (chunks - 3) * 16);
+
+    /* Linear block write in tail chunk, getters take no chunk */
+    SEG_TEST(lwrb_seg_get_linear_block_write_length(&a) == 6);
+    addr = lwrb_seg_get_linear_block_write_address(&a);
+    SEG_TEST(addr != NULL);
+    memcpy(addr, "xyzXYZ", 6);
+    SEG_TEST(lwrb_seg_advance(&a, 6) == 6);
+    SEG_TEST(lwrb_seg_get_linear_block_write_length(&a) == 0);
+    SEG_TEST(lwrb_seg_get_linear_block_write_address(&a) == NULL);
+    SEG_TEST(lwrb_seg_advance(&a, 1) == 0);
+
+    /* Reserve returns consumed chunk to the pool and takes new one */
+    SEG_TEST(lwrb_seg_reserve(&a) == 16);
+    SEG_TEST(lwrb_seg_pool_get_free(&pool) == chunks - 4);
+    addr = lwrb_seg_get_linear_block_write_address(&a);
+    SEG_TEST(addr != NULL);
+    memcpy(addr, "uvw", 3);
+    SEG_TEST(lwrb_seg_advance(&a, 3) == 3);
+    SEG_TEST(lwrb_seg_get_linear_block_write_length(&a) == 13);
+    SEG_TEST(lwrb_seg_advance(&a, 20) == 13); /* Limited to tail chunk */
+    SEG_TEST(lwrb_seg_get_full(&a) == 22);
+    SEG_TEST(lwrb_seg_peek(&a, 4, tmp, 4) == 4 && memcmp(tmp, "YZuv", 4) == 0);
+    SEG_TEST(lwrb_seg_read(&a, tmp, sizeof(tmp)) == 22 && memcmp(tmp, "xyzXYZuvw", 9) == 0);
+
+    /* Pool budget limits all buffers, last chunk of empty buffer stays in the buffer */
+    lwrb_seg_reset(&b);
+    SEG_TEST(lwrb_seg_pool_get_free(&pool) == chunks - 2);
+    SEG_TEST(lwrb_seg_write(&a, tmp, sizeof(tmp))
+             == (sizeof(tmp) < (chunks - 1) * 16 ? sizeof(tmp) : (chunks - 1) * 16));
+    lwrb_seg_reset(&a);
+    SEG_TEST(lwrb_seg_pool_get_free(&pool) == chunks);
+
+    /* Producer and consumer in different threads */
+    SEG_TEST(lwrb_seg_pool_init(&pool, pool_mem, sizeof(pool_mem), 16));
+    SEG_TEST(lwrb_seg_init(&a, &pool, 40));
+    {
+        pthread_t thread;
+        uint32_t expected = 0;
+        lwrb_sz_t len;
+
+        pthread_create(&thread, NULL, producer_thread, NULL);
+        while (expected < SEG_TRANSFER_BYTES) {
+            if ((expected & 0x01) == 0) {
+                len = lwrb_seg_read(&a, tmp, 1 + (expected % sizeof(tmp)));
+            } else {
+                len = lwrb_seg_get_linear_block_read_length(&a);
+                if (len > 0) {
+                    memcpy(tmp, lwrb_seg_get_linear_block_read_address(&a), len);
+                    lwrb_seg_skip(&a, len);
+                }
+            }
+            if (len == 0) {
+                sched_yield();
+            }
+            for (lwrb_sz_t i = 0; i < len; ++i, ++expected) {
+                if (tmp[i] != (uint8_t)(expected * 7)) {
+                    retval = -1;
+                }
+            }
+        }
+        pthread_join(thread, NULL);
+        SEG_TEST(expected == SEG_TRANSFER_BYTES);
+        SEG_TEST(lwrb_seg_get_full(&a) == 0);
+        lwrb_seg_reset(&a);
+        SEG_TEST(lwrb_seg_pool_get_free(&pool) == chunks);
+    }
+    return retval;
+}
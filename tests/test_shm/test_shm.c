@@ -0,0 +1,112 @@
+#include <stdio.h>
+#include <string.h>
+#include <sys/wait.h>
+#include <unistd.h>
+#include "lwrb/lwrb.h"
+
+#define SHM_TEST(_cond_)                                                                                               \
+    do {                                                                                                               \
+        if (!(_cond_)) {                                                                                               \
+            printf("Test failed on line %u\r\n", (unsigned)__LINE__);                                                  \
+            retval = -1;                                                                                               \
+        }                                                                                                              \
+    } while (0)
+
+#define STREAM_LEN (8UL * 1024UL * 1024UL)
+
+static uint8_t
+prv_pattern(lwrb_sz_t pos) {
+    return (uint8_t)((pos * 2654435761UL) >> 13);
+}
+
+/* Consumer process, attaches by name and verifies the stream */
+static int
+prv_consumer(const char* name) {
+    lwrb_shm_t shm;
+    uint8_t data[1000];
+    lwrb_sz_t pos = 0, len;
+
+    while (!lwrb_shm_attach(&shm, name)) {
+        usleep(1000);
+    }
+    while (pos < STREAM_LEN) {
+        len = lwrb_shm_read(&shm, data, sizeof(data));
+        for (lwrb_sz_t i = 0; i < len; ++i) {
+            if (data[i] != prv_pattern(pos + i)) {
+                return 1;
+            }
+        }
+        pos += len;
+    }
+    lwrb_shm_close(&shm);
+    return 0;
+}
+
+int
+test_run(void) {
+    int retval = 0, status = -1;
+    char name[64];
+    static uint8_t mem[LWRB_SHM_MEM_SIZE(64)] __attribute__((aligned(64)));
+    lwrb_shm_t a, b;
+    uint8_t tmp[100];
+    pid_t pid;
+
+    /* Layout in application memory, second handle as if mapped by other process */
+    SHM_TEST(!lwrb_shm_format(&a, mem, 48));
+    SHM_TEST(!lwrb_shm_bind(&b, mem, sizeof(mem)));
+    SHM_TEST(lwrb_shm_format(&a, mem, 64));
+    SHM_TEST(!lwrb_shm_bind(&b, mem, sizeof(mem) - 1));
+    SHM_TEST(lwrb_shm_bind(&b, mem, sizeof(mem)));
+    SHM_TEST(lwrb_shm_get_free(&a) == 64);
+    for (size_t i = 0; i < sizeof(tmp); ++i) {
+        tmp[i] = (uint8_t)i;
+    }
+    SHM_TEST(lwrb_shm_write(&a, tmp, 50) == 50);
+    SHM_TEST(lwrb_shm_get_full(&b) == 50);
+    SHM_TEST(lwrb_shm_read(&b, tmp, 40) == 40 && tmp[0] == 0 && tmp[39] == 39);
+    for (size_t i = 0; i < sizeof(tmp); ++i) {
+        tmp[i] = (uint8_t)(100 + i);
+    }
+    SHM_TEST(lwrb_shm_write(&a, tmp, 100) == 54);
+    SHM_TEST(lwrb_shm_get_free(&a) == 0);
+    SHM_TEST(lwrb_shm_read(&b, tmp, sizeof(tmp)) == 64);
+    SHM_TEST(tmp[0] == 40 && tmp[9] == 49 && tmp[10] == 100 && tmp[63] == 153);
+
+    /* Indices corrupted by other process are rejected, not used for copy */
+    atomic_store(&a.hdr->w_ptr, atomic_load(&a.hdr->r_ptr) + 65);
+    SHM_TEST(lwrb_shm_read(&b, tmp, sizeof(tmp)) == 0);
+    SHM_TEST(lwrb_shm_get_full(&b) == 0);
+    SHM_TEST(lwrb_shm_write(&a, tmp, 1) == 0);
+    SHM_TEST(lwrb_shm_get_free(&a) == 0);
+    a.hdr->size = 1024;
+    SHM_TEST(lwrb_shm_read(&b, tmp, sizeof(tmp)) == 0);
+    a.hdr->size = 64;
+    atomic_store(&a.hdr->w_ptr, atomic_load(&a.hdr->r_ptr));
+
+    /* Producer and consumer in different processes */
+    snprintf(name, sizeof(name), "/lwrb_test_%ld", (long)getpid());
+    pid = fork();
+    if (pid == 0) {
+        _exit(prv_consumer(name));
+    }
+    SHM_TEST(pid > 0);
+    SHM_TEST(lwrb_shm_create(&a, name, 4096));
+    SHM_TEST(!lwrb_shm_create(&b, name, 4096));
+    {
+        uint8_t data[777];
+        lwrb_sz_t pos = 0;
+
+        while (pos < STREAM_LEN) {
+            lwrb_sz_t len = STREAM_LEN - pos < sizeof(data) ? STREAM_LEN - pos : sizeof(data);
+            for (lwrb_sz_t i = 0; i < len; ++i) {
+                data[i] = prv_pattern(pos + i);
+            }
+            pos += lwrb_shm_write(&a, data, len);
+        }
+    }
+    waitpid(pid, &status, 0);
+    SHM_TEST(WIFEXITED(status) && WEXITSTATUS(status) == 0);
+    lwrb_shm_close(&a);
+    SHM_TEST(lwrb_shm_unlink(name));
+    return retval;
+}
@@ -0,0 +1,120 @@
+#include <stddef.h>
+#include <stdio.h>
+#include <string.h>
+#include "lwrb/lwrb.h"
+
+uint8_t lwrb_data[8 + 1];
+lwrb_t buff;
+
+uint8_t tmp[8];
+size_t reset_evts;
+
+static void
+evt_fn(lwrb_t* b, lwrb_evt_type_t type, lwrb_sz_t len) {
+    (void)b;
+    (void)len;
+    if (type == LWRB_EVT_RESET) {
+        ++reset_evts;
+    }
+}
+
+#define STATS_TEST(_cond_)                                                                                             \
+    do {                                                                                                               \
+        if (!(_cond_)) {                                                                                               \
+            printf("Test failed on line %u\r\n", (unsigned)__LINE__);                                                  \
+            retval = -1;                                                                                               \
+        }                                                                                                              \
+    } while (0)
+
+int
+test_run(void) {
+    int retval = 0;
+    lwrb_stats_t st;
+
+    lwrb_init(&buff, lwrb_data, sizeof(lwrb_data));
+
+    printf("Initial state test\r\n");
+    {
+        /* Producer and consumer counters never share cache line */
+        STATS_TEST(offsetof(lwrb_t, w_stats) % LWRB_CACHELINE_SIZE == 0);
+        STATS_TEST(offsetof(lwrb_t, r_stats) % LWRB_CACHELINE_SIZE == 0);
+        STATS_TEST(lwrb_get_stats(NULL, &st) == 0);
+        STATS_TEST(lwrb_get_stats(&buff, NULL) == 0);
+        STATS_TEST(lwrb_get_stats(&buff, &st) == 1);
+        STATS_TEST(st.bytes_in == 0 && st.bytes_out == 0 && st.peak_full == 0);
+    }
+
+    printf("Write test\r\n");
+    {
+        lwrb_write(&buff, "abcde", 5);
+        lwrb_write(&buff, "fghij", 5); /* Short write, only 3 bytes fit */
+        lwrb_write(&buff, "k", 1);     /* Failed write */
+        lwrb_write_ex(&buff, "k", 1, NULL, LWRB_FLAG_WRITE_ALL);
+        lwrb_get_stats(&buff, &st);
+        STATS_TEST(st.bytes_in == 8);
+        STATS_TEST(st.write_short == 1);
+        STATS_TEST(st.write_failed == 2);
+        STATS_TEST(st.peak_full == 8);
+        STATS_TEST(st.full_count == 1);
+    }
+
+    printf("Read test\r\n");
+    {
+        lwrb_read(&buff, tmp, 3);
+        lwrb_skip(&buff, 2);
+        lwrb_read(&buff, tmp, 8); /* Short read, only 3 bytes available */
+        lwrb_read(&buff, tmp, 1); /* Failed read */
+        lwrb_get_stats(&buff, &st);
+        STATS_TEST(st.bytes_out == 8);
+        STATS_TEST(st.read_short == 1);
+        STATS_TEST(st.read_failed == 1);
+        STATS_TEST(st.empty_count == 1);
+
+        /* Peek does not modify statistics */
+        lwrb_write(&buff, "ab", 2);
+        lwrb_peek(&buff, 0, tmp, 2);
+        lwrb_read(&buff, tmp, 2);
+        lwrb_get_stats(&buff, &st);
+        STATS_TEST(st.bytes_in == 10 && st.bytes_out == 10);
+        STATS_TEST(st.empty_count == 2 && st.peak_full == 8);
+    }
+
+    printf("Vectored and block test\r\n");
+    {
+        lwrb_iovec_t iov[2] = {{"abc", 3}, {"def", 3}};
+        lwrb_iovec_t spans[2];
+
+        lwrb_sz_t len;
+
+        lwrb_writev(&buff, iov, 2);
+        len = lwrb_write_reserve(&buff, 4, spans); /* Only 2 bytes fit */
+        lwrb_write_commit(&buff, len);
+        lwrb_advance(&buff, 1); /* Failed write */
+        lwrb_get_stats(&buff, &st);
+        STATS_TEST(st.bytes_in == 18);
+        STATS_TEST(st.write_failed == 3);
+        STATS_TEST(st.full_count == 2);
+    }
+
+    printf("Overwrite test\r\n");
+    {
+        lwrb_sz_t bytes_out;
+
+        lwrb_reset(&buff);
+        lwrb_get_stats(&buff, &st);
+        bytes_out = st.bytes_out;
+        lwrb_set_evt_fn(&buff, evt_fn);
+        lwrb_write(&buff, "abcdef", 6);
+        lwrb_overwrite(&buff, "xyz", 3); /* 1 byte dropped */
+        lwrb_overwrite(&buff, "0123456789", 10); /* 8 bytes in buffer and 2 input bytes dropped */
+        lwrb_get_stats(&buff, &st);
+        STATS_TEST(st.overwritten == 11);
+        STATS_TEST(st.bytes_out == bytes_out); /* Dropped bytes are not read by consumer */
+        STATS_TEST(lwrb_get_full(&buff) == 8);
+        STATS_TEST(reset_evts == 1); /* Oversized input resets the buffer */
+        lwrb_set_evt_fn(&buff, NULL);
+    }
+
+    printf("Done\r\n");
+    return retval;
+}
@@ -0,0 +1,119 @@
+#include "lwrb/lwrb.h" /* First, it may define feature macros for system headers */
+
+#include <pthread.h>
+#include <stdio.h>
+#include <string.h>
+#include <time.h>
+
+#define TRANSFER_BYTES 1000000
+
+uint8_t lwrb_data[64 + 1];
+lwrb_t buff;
+
+#define WAIT_TEST(_cond_)                                                                                              \
+    do {                                                                                                               \
+        if (!(_cond_)) {                                                                                               \
+            printf("Test failed on line %u\r\n", (unsigned)__LINE__);                                                  \
+            retval = -1;                                                                                               \
+        }                                                                                                              \
+    } while (0)
+
+static uint32_t tx_checksum;
+
+static double
+now_ms(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (double)ts.tv_sec * 1000.0 + (double)ts.tv_nsec / 1e6;
+}
+
+static void*
+delayed_writer_thread(void* arg) {
+    struct timespec delay = {.tv_sec = 0, .tv_nsec = 50 * 1000000L};
+
+    (void)arg;
+    nanosleep(&delay, NULL);
+    lwrb_write(&buff, "abcd", 4);
+    return NULL;
+}
+
+static void*
+producer_thread(void* arg) {
+    uint8_t chunk[13];
+    size_t sent = 0;
+
+    (void)arg;
+    while (sent < TRANSFER_BYTES) {
+        lwrb_sz_t len = TRANSFER_BYTES - sent < sizeof(chunk) ? TRANSFER_BYTES - sent : sizeof(chunk);
+        for (lwrb_sz_t i = 0; i < len; ++i) {
+            chunk[i] = (uint8_t)(sent + i);
+            tx_checksum += chunk[i];
+        }
+        lwrb_write_wait(&buff, len, LWRB_WAIT_FOREVER);
+        sent += lwrb_write(&buff, chunk, len);
+    }
+    return NULL;
+}
+
+int
+test_run(void) {
+    int retval = 0;
+    pthread_t thread;
+    uint8_t data[32];
+    double start;
+
+    lwrb_init(&buff, lwrb_data, sizeof(lwrb_data));
+
+    printf("Timeout test\r\n");
+    {
+        WAIT_TEST(lwrb_read_wait(&buff, 1, 0) == 0);
+        start = now_ms();
+        WAIT_TEST(lwrb_read_wait(&buff, 1, 20) == 0);
+        WAIT_TEST(now_ms() - start >= 19.0);
+
+        lwrb_write(&buff, "ab", 2);
+        WAIT_TEST(lwrb_read_wait(&buff, 2, 0) == 1);
+        WAIT_TEST(lwrb_read_wait(&buff, 3, 10) == 0);
+        WAIT_TEST(lwrb_write_wait(&buff, 62, 0) == 1);
+        WAIT_TEST(lwrb_write_wait(&buff, 63, 10) == 0);
+        WAIT_TEST(lwrb_write_wait(&buff, 1000, 10) == 0); /* Limited to capacity, buffer is not empty */
+        lwrb_reset(&buff);
+        WAIT_TEST(lwrb_write_wait(&buff, 1000, 0) == 1);
+    }
+
+    printf("Wake-up test\r\n");
+    {
+        /* Reader parks and gets woken by writer */
+        start = now_ms();
+        pthread_create(&thread, NULL, delayed_writer_thread, NULL);
+        WAIT_TEST(lwrb_read_wait(&buff, 4, 5000) == 1);
+        WAIT_TEST(now_ms() - start < 4000.0);
+        WAIT_TEST(lwrb_read(&buff, data, sizeof(data)) == 4 && memcmp(data, "abcd", 4) == 0);
+        pthread_join(thread, NULL);
+    }
+
+    printf("Transfer test\r\n");
+    {
+        uint32_t rx_checksum = 0;
+        size_t received = 0;
+
+        lwrb_reset(&buff);
+        pthread_create(&thread, NULL, producer_thread, NULL);
+        while (received < TRANSFER_BYTES) {
+            lwrb_sz_t len;
+
+            WAIT_TEST(lwrb_read_wait(&buff, 1, LWRB_WAIT_FOREVER) == 1);
+            len = lwrb_read(&buff, data, sizeof(data));
+            for (lwrb_sz_t i = 0; i < len; ++i) {
+                WAIT_TEST(data[i] == (uint8_t)(received + i));
+                rx_checksum += data[i];
+            }
+            received += len;
+        }
+        pthread_join(thread, NULL);
+        WAIT_TEST(rx_checksum == tx_checksum);
+    }
+
+    printf("Done\r\n");
+    return retval;
+}
@@ -0,0 +1,103 @@
+#include <stdio.h>
+#include <string.h>
+#include "lwrb/lwrb.h"
+
+uint8_t lwrb_data[8 + 1];
+lwrb_t buff;
+
+uint8_t tmp[8];
+
+/* Last received event */
+static int evt_count;
+static lwrb_evt_type_t evt_type;
+static lwrb_sz_t evt_bp;
+
+#define WM_TEST(_cond_)                                                                                                \
+    do {                                                                                                               \
+        if (!(_cond_)) {                                                                                               \
+            printf("Test failed on line %u\r\n", (unsigned)__LINE__);                                                  \
+            retval = -1;                                                                                               \
+        }                                                                                                              \
+    } while (0)
+
+/* Check number of events since last check and type of last one */
+#define WM_EVT_TEST(_count_, _type_, _bp_)                                                                             \
+    do {                                                                                                               \
+        WM_TEST(evt_count == (_count_) && ((_count_) == 0 || (evt_type == (_type_) && evt_bp == (_bp_))));             \
+        evt_count = 0;                                                                                                 \
+    } while (0)
+
+static void
+my_buff_evt_fn(lwrb_t* buff, lwrb_evt_type_t type, lwrb_sz_t bp) {
+    (void)buff;
+    ++evt_count;
+    evt_type = type;
+    evt_bp = bp;
+}
+
+int
+test_run(void) {
+    int retval = 0;
+
+    lwrb_init(&buff, lwrb_data, sizeof(lwrb_data));
+    lwrb_set_evt_fn(&buff, my_buff_evt_fn);
+
+    printf("Per operation event test\r\n");
+    {
+        lwrb_write(&buff, "ab", 2);
+        WM_EVT_TEST(1, LWRB_EVT_WRITE, 2);
+        lwrb_read(&buff, tmp, 2);
+        WM_EVT_TEST(1, LWRB_EVT_READ, 2);
+    }
+
+    printf("Watermark argument test\r\n");
+    {
+        WM_TEST(lwrb_set_evt_watermarks(&buff, 4, 4) == 0);
+        WM_TEST(lwrb_set_evt_watermarks(&buff, 4, 0) == 0);
+        WM_TEST(lwrb_set_evt_watermarks(NULL, 2, 6) == 0);
+        WM_TEST(lwrb_set_evt_watermarks(&buff, 0, 0) == 1);
+    }
+
+    printf("High/low watermark test\r\n");
+    {
+        lwrb_reset(&buff);
+        WM_EVT_TEST(1, LWRB_EVT_RESET, 0);
+        WM_TEST(lwrb_set_evt_watermarks(&buff, 2, 6) == 1);
+
+        lwrb_write(&buff, "abcd", 4);
+        WM_EVT_TEST(0, 0, 0); /* Below high watermark */
+        lwrb_write(&buff, "ef", 2);
+        WM_EVT_TEST(1, LWRB_EVT_HIGH_WATERMARK, 6);
+        lwrb_write(&buff, "g", 1);
+        WM_EVT_TEST(0, 0, 0); /* Already above, no new edge */
+
+        lwrb_read(&buff, tmp, 4);
+        WM_EVT_TEST(0, 0, 0); /* Above low watermark */
+        lwrb_skip(&buff, 1);
+        WM_EVT_TEST(1, LWRB_EVT_LOW_WATERMARK, 2);
+        lwrb_skip(&buff, 2);
+        WM_EVT_TEST(0, 0, 0); /* Already below, no new edge */
+
+        /* Single write crossing high watermark from empty buffer */
+        lwrb_advance(&buff, 8);
+        WM_EVT_TEST(1, LWRB_EVT_HIGH_WATERMARK, 8);
+        lwrb_skip(&buff, 8);
+        WM_EVT_TEST(1, LWRB_EVT_LOW_WATERMARK, 0);
+    }
+
+    printf("Non-empty edge test\r\n");
+    {
+        WM_TEST(lwrb_set_evt_watermarks(&buff, 0, 1) == 1);
+        lwrb_write(&buff, "a", 1);
+        WM_EVT_TEST(1, LWRB_EVT_HIGH_WATERMARK, 1);
+        lwrb_write(&buff, "b", 1);
+        WM_EVT_TEST(0, 0, 0);
+        lwrb_read(&buff, tmp, 1);
+        WM_EVT_TEST(0, 0, 0);
+        lwrb_read(&buff, tmp, 1);
+        WM_EVT_TEST(1, LWRB_EVT_LOW_WATERMARK, 0);
+    }
+
+    printf("Done\r\n");
+    return retval;
+}